@@ -48,11 +48,13 @@ HaCClientInfo::HaCClientInfo(tcp_pcb* soc, std::function<void(HaCClientInfo*, tc
 {
 
      this->_soc = soc; 
-     this->_onAcceptedFn = fn;     
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onAccepted = fn;
 
      this->_setup();
 
-     if(this->_onAcceptedFn) this->_onAcceptedFn(this, soc);
+     if(fn) fn(this, soc);
 
 }
 
@@ -62,6 +64,27 @@ HaCClientInfo::HaCClientInfo(tcp_pcb* soc, std::function<void(HaCClientInfo*, tc
 HaCClientInfo::~HaCClientInfo() 
 {
      DBG_CB_HSOC("\n[HACCLIENTINFO] Destroying HaCClientInfo..");
+     //lwIP would call back into a deleted object otherwise
+     if(this->_soc)
+     {
+          this->_detach();
+          tcp_abort(this->_soc);
+          this->_soc = nullptr;
+     }
+     if(this->_lingerSoc)
+     {
+          tcp_arg(this->_lingerSoc, NULL);
+          tcp_sent(this->_lingerSoc, NULL);
+          tcp_err(this->_lingerSoc, NULL);
+          tcp_abort(this->_lingerSoc);
+     }
+     HaCTimerWheel::instance().stop(&this->_timer);
+     HaCDnsCache::instance().cancel(this);
+     //Shared buffers are handed back, the application isn't told anymore
+     this->_txQueue.clear(nullptr, nullptr);
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     delete this->_ownCallbacks;
+     #endif
 }
 
 /**
@@ -74,22 +97,227 @@ void HaCClientInfo::setupClientSocket(tcp_pcb* soc)
      this->_setup();
 }
 
+/**
+     * Reset the connection state so the object can be reused for a new connection
+     */
+void HaCClientInfo::reset() 
+{
+     this->_soc = nullptr;
+     HaCTimerWheel::instance().stop(&this->_timer);
+     this->_isRemoteEndNotOk = false;
+     this->_connectionNotOkCntr = 0;
+     this->_connecting = false;
+     this->_resolving = false;
+     HaCDnsCache::instance().cancel(this);
+     this->_manualReceiveWindow = false;
+     this->_unconsumed = 0;
+     this->_withheld = 0;
+     this->_txHighWatermark = HAC_SOCCLIENT_TX_HIGH_WATERMARK;
+     this->_txLowWatermark = HAC_SOCCLIENT_TX_HIGH_WATERMARK / 2;
+     this->_slowConsumerPolicy = HAC_SLOW_CONSUMER_DROP_NEWEST;
+     this->_txAboveHigh = false;
+     this->_slowConsumer = false;
+     this->_noDelay = false;
+     this->_txQueue.setCorked(false);
+     this->_connectionId = HAC_CONNECTION_HANDLE_INVALID;
+     this->_receiveMode = HAC_RX_MODE_TEXT;
+     this->_framer.reset();
+     //A draining connection keeps what lwIP still reads from
+     if(!this->_lingerSoc)
+          this->_txQueue.clear(&HaCClientInfo::_onSendDone, this);
+     //A pooled slot may be taken next by another server
+     this->setCallbacks(nullptr);
+}
 
 /**
-     * Send data
+     * Send data, what doesn't fit on the socket send buffer is queued and 
+     * written as soon as the remote end acknowledges the previous data.
+     * See send(data, len) for the largest message accepted.
      * @param buffer data to be sent
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return ERR_OK if the data is sent or queued, ERR_MEM if the send queue is full or the message too big
+     */
+long HaCClientInfo::sendData(const char * buffer, HaCMessageToken *token) 
+{
+     return this->send(buffer, strlen(buffer), token);
+}
+
+/**
+     * Send binary data, a message is taken whole: it has to fit on the free socket 
+     * send buffer plus the HAC_SOCCLIENT_TX_BUFFER_SIZE bytes of queue. A bigger one 
+     * returns ERR_MEM even on an idle connection and has to be sent in smaller parts.
+     * @param data data to be sent
+     * @param len data length
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return ERR_OK if the data is sent or queued, ERR_MEM if the send queue is full or the message too big, 
+     * ERR_VAL over 0xFFFF bytes
      */
-long HaCClientInfo::sendData(const char * buffer) 
+long HaCClientInfo::send(const void *data, size_t len, HaCMessageToken *token) 
 {
-     //TO DO: Manage a chunk send data
-     return tcp_write(this->_soc, buffer, strlen(buffer), TCP_WRITE_FLAG_COPY);     
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_soc)
+          return ERR_CONN;
+
+     if(len > 0xFFFF)
+          return ERR_VAL;
+
+     err_t err = this->_admit(len);
+     if(err != ERR_OK)
+          return err;
+
+     err = this->_txQueue.push(this->_soc, (const uint8_t*)data, (uint16_t)len);
+     return this->_queued(err, token);
+}
+
+/**
+     * Send several buffers back to back(e.g. header, payload and trailer) 
+     * without building an intermediate buffer, the size limit of send(data, len) 
+     * applies to the total.
+     * @param segments buffers to be sent
+     * @param count number of buffers
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return ERR_OK if the data is sent or queued, ERR_MEM if the send queue is full or the message too big
+     */
+long HaCClientInfo::send(const HaCSendSegment *segments, uint8_t count, HaCMessageToken *token) 
+{
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_soc)
+          return ERR_CONN;
+
+     uint32_t total = 0;
+     for(uint8_t i = 0; i < count; i++)
+          total += segments[i].len;
+
+     err_t err = this->_admit(total);
+     if(err != ERR_OK)
+          return err;
+
+     err = this->_txQueue.push(this->_soc, segments, count);
+     return this->_queued(err, token);
+}
+
+/**
+     * Send data without copying it, the buffer is written straight to the socket.
+     * The buffer must stay untouched until the onBufferReleased callback reports it.
+     * @param data data to be sent
+     * @param len data length
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return ERR_OK if the data is sent or queued, ERR_MEM if the send queue is full
+     */
+long HaCClientInfo::sendNoCopy(const void *data, size_t len, HaCMessageToken *token) 
+{
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_soc)
+          return ERR_CONN;
+
+     if(len > 0xFFFF)
+          return ERR_VAL;
+
+     err_t err = this->_admit(len);
+     if(err != ERR_OK)
+          return err;
+
+     err = this->_txQueue.push(this->_soc, (const uint8_t*)data, (uint16_t)len, false);
+     return this->_queued(err, token);
+}
+
+/**
+     * Send a shared buffer without copying it, the connection holds a reference 
+     * until the data is acknowledged.
+     * @param buffer shared buffer to be sent
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return ERR_OK if the data is sent or queued, ERR_MEM if the send queue is full
+     */
+long HaCClientInfo::sendShared(HaCSharedBuffer *buffer, HaCMessageToken *token) 
+{
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_soc)
+          return ERR_CONN;
+
+     err_t err = this->_admit(buffer ? buffer->length() : 0);
+     if(err != ERR_OK)
+          return err;
+
+     err = this->_txQueue.push(this->_soc, buffer);
+     return this->_queued(err, token);
+}
+
+/**
+     * Hint that more sends follow, until uncork is called. The writes are flagged 
+     * TCP_WRITE_FLAG_MORE(no PSH) and the sends don't call tcp_output even with setNoDelay.
+     * It is a hint only, lwIP still transmits what it has on its own(e.g. when an ack comes in).
+     */
+void HaCClientInfo::cork()
+{
+     this->_txQueue.setCorked(true);
+}
+
+/**
+     * End the batch started by cork, PSH is set again and the queued data is transmitted right away
+     * @return Socket error state
+     */
+err_t HaCClientInfo::uncork()
+{
+     this->_txQueue.setCorked(false);
+     return this->flush();
+}
+
+/**
+     * Check if a batch started by cork is open
+     * @return True if corked
+     */
+bool HaCClientInfo::isCorked() const
+{
+     return this->_txQueue.isCorked();
+}
+
+/**
+     * Write the queued data that fits on the send buffer and let lwIP transmit it 
+     * now instead of on its next timer tick
+     * @return Socket error state
+     */
+err_t HaCClientInfo::flush()
+{
+     if(!this->_soc)
+          return ERR_CONN;
+
+     err_t err = this->_txQueue.flush(this->_soc);
+     if(err != ERR_OK)
+          return err;
+
+     return tcp_output(this->_soc);
+}
+
+/**
+     * Turn the Nagle algorithm off for minimum latency, every send that isn't corked 
+     * is then transmitted right away. With Nagle on(Default) lwIP merges small sends.
+     * @param enable True to disable Nagle
+     */
+void HaCClientInfo::setNoDelay(bool enable)
+{
+     this->_noDelay = enable;
+     if(!this->_soc)
+          return;
+
+     if(enable)
+          tcp_nagle_disable(this->_soc);
+     else
+          tcp_nagle_enable(this->_soc);
 }
 
 /**
      * Set Connection ID
      * @param id Connection ID
      */
-void HaCClientInfo::setConnectionId(uint8_t id)
+void HaCClientInfo::setConnectionId(HaCConnectionHandle id)
 {
      this->_connectionId = id;
 }
@@ -98,7 +326,7 @@ void HaCClientInfo::setConnectionId(uint8_t id)
      * Get Connection ID
      * @return Connection ID     
      */
-uint8_t HaCClientInfo::getConnectionId()
+HaCConnectionHandle HaCClientInfo::getConnectionId()
 {
      return this->_connectionId;
 }
@@ -110,8 +338,210 @@ uint8_t HaCClientInfo::getConnectionId()
      */
 bool HaCClientInfo::setPingWatchdog(bool enable)
 {    
-     this->_enablePingWatchdog = enable;
-     return this->_enablePingWatchdog;
+     return this->setPingWatchdog(enable ? HAC_WATCHDOG_PING : HAC_WATCHDOG_OFF);
+}
+
+/**
+     * Set the dead peer detection mode
+     * @param mode HAC_WATCHDOG_OFF, HAC_WATCHDOG_PING or HAC_WATCHDOG_KEEPALIVE
+     * @param idleMs Keepalive only, idle time before the first probe
+     * @param intervalMs Keepalive only, time between probes
+     * @param count Keepalive only, unanswered probes before the connection is dropped
+     * @return Return watchdog enable state
+     */
+bool HaCClientInfo::setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs, uint32_t intervalMs, uint8_t count)
+{    
+     this->_watchdogMode = mode;
+     this->_keepAliveIdle = idleMs;
+     this->_keepAliveInterval = intervalMs;
+     this->_keepAliveCount = count;
+     this->_applyWatchdog();
+     this->_armTimer();
+
+     return this->_watchdogMode != HAC_WATCHDOG_OFF;
+}
+
+/**
+     * Get the dead peer detection mode
+     * @return Watchdog mode
+     */
+HaCWatchdogMode HaCClientInfo::getWatchdogMode() const
+{    
+     return this->_watchdogMode;
+}
+
+/**
+     * Time of the last acknowledged data
+     * @return millis() of the last ack, or of the connection setup
+     */
+uint32_t HaCClientInfo::lastAckMillis() const
+{    
+     return this->_lastAckMs;
+}
+
+/**
+     * Time of the last received data
+     * @return millis() of the last receive, or of the connection setup
+     */
+uint32_t HaCClientInfo::lastReceiveMillis() const
+{    
+     return this->_lastReceiveMs;
+}
+
+/**
+     * Let the application open the receive window instead of reopening it as soon as 
+     * the data is delivered, a peer can then only send as much as the application consumes
+     * @param enable True to open the window with consume, false to open it on receive(Default)
+     */
+void HaCClientInfo::setManualReceiveWindow(bool enable)
+{    
+     this->_manualReceiveWindow = enable;
+     if(!enable)
+          this->consume(this->_unconsumed);
+}
+
+/**
+     * Reopen the receive window for data the application is done with(Manual receive window)
+     * @param len Number of bytes consumed, limited to the unconsumed bytes
+     */
+void HaCClientInfo::consume(uint32_t len)
+{    
+     if(len > this->_unconsumed)
+          len = this->_unconsumed;
+
+     this->_unconsumed -= len;
+     while(len && this->_soc)
+     {
+          uint16_t chunk = len > 0xFFFF ? 0xFFFF : (uint16_t)len;
+          tcp_recved(this->_soc, chunk);
+          len -= chunk;
+     }
+}
+
+/**
+     * Bytes received but not consumed yet(Manual receive window)
+     * @return Unconsumed bytes
+     */
+uint32_t HaCClientInfo::unconsumedBytes() const
+{    
+     return this->_unconsumed;
+}
+
+/**
+     * Limit the unacknowledged data of the connection so a peer that stops reading
+     * can't take up the lwIP memory shared by every connection.
+     * Once high is reached the slow consumer policy applies to new data, onWritable 
+     * is raised when the queue drains down to low.
+     * @param high Unacknowledged bytes before the connection is a slow consumer, 0 to disable
+     * @param low Unacknowledged bytes before onWritable is raised, 0 for half of high
+     */
+void HaCClientInfo::setSendWatermarks(uint32_t high, uint32_t low)
+{    
+     if(!low || low > high)
+          low = high / 2;
+
+     this->_txHighWatermark = high;
+     this->_txLowWatermark = low;
+}
+
+/**
+     * Set what happens to new data once the send high watermark is reached
+     * @param policy HAC_SLOW_CONSUMER_DROP_NEWEST, HAC_SLOW_CONSUMER_DROP_OLDEST or HAC_SLOW_CONSUMER_DISCONNECT
+     */
+void HaCClientInfo::setSlowConsumerPolicy(HaCSlowConsumerPolicy policy)
+{    
+     this->_slowConsumerPolicy = policy;
+}
+
+/**
+     * Bytes queued or written but not yet acknowledged by the remote end
+     * @return Pending byte count
+     */
+uint32_t HaCClientInfo::pendingSendBytes() const
+{    
+     return this->_txQueue.pendingBytes();
+}
+
+/**
+     * Check if the connection is below its send high watermark
+     * @return True if new data is accepted without applying the slow consumer policy
+     */
+bool HaCClientInfo::isWritable() const
+{    
+     return this->_soc && !this->_slowConsumer && 
+            (!this->_txHighWatermark || this->_txQueue.pendingBytes() < this->_txHighWatermark);
+}
+
+/**
+     * Close the connection once it has neither acknowledged nor received data for a while
+     * @param timeoutMs Idle time in ms, 0 to disable
+     */
+void HaCClientInfo::setIdleTimeout(uint32_t timeoutMs)
+{    
+     this->_idleTimeoutMs = timeoutMs;
+     this->_armTimer();
+}
+
+/**
+     * Set the receive data mode
+     * @param mode HAC_RX_MODE_TEXT, HAC_RX_MODE_BINARY, HAC_RX_MODE_DELIMITED or HAC_RX_MODE_LENGTH_PREFIXED
+     */
+void HaCClientInfo::setReceiveMode(HaCReceiveMode mode)
+{
+     if(mode == HAC_RX_MODE_DELIMITED && !this->_framer.isDelimited())
+     {
+          this->setLineFraming();
+          return;
+     }
+
+     if(mode == HAC_RX_MODE_LENGTH_PREFIXED && !this->_framer.isLengthPrefixed())
+     {
+          this->setLengthPrefixFraming();
+          return;
+     }
+
+     this->_receiveMode = mode;
+}
+
+/**
+     * Get the receive data mode
+     * @return Receive data mode
+     */
+HaCReceiveMode HaCClientInfo::getReceiveMode() const
+{
+     return this->_receiveMode;
+}
+
+/**
+     * Enable delimiter framing, partial lines are kept across segments and 
+     * the onReceive callback is fired once per complete line without the delimiter.
+     * @param delimiter Line delimiter, up to HAC_FRAMER_MAX_DELIMITER_LEN characters
+     * @param maxLength Maximum line length, longer lines are dropped
+     * @return True if the framing is enabled
+     */
+bool HaCClientInfo::setLineFraming(const char *delimiter, uint16_t maxLength)
+{
+     if(!this->_framer.setDelimiter(delimiter, maxLength))
+          return false;
+
+     this->_receiveMode = HAC_RX_MODE_DELIMITED;
+     return true;
+}
+
+/**
+     * Enable length prefixed framing, frames are reassembled across segments and 
+     * the onReceive callback is fired once per complete frame without its header.
+     * @param prefix HAC_LEN_PREFIX_VARINT, HAC_LEN_PREFIX_U16 or HAC_LEN_PREFIX_U32
+     * @param maxLength Maximum frame length, longer frames are skipped
+     * @return True if the framing is enabled
+     */
+bool HaCClientInfo::setLengthPrefixFraming(HaCLengthPrefix prefix, uint16_t maxLength)
+{
+     if(!this->_framer.setLengthPrefix(prefix, maxLength))
+          return false;
+
+     this->_receiveMode = HAC_RX_MODE_LENGTH_PREFIXED;
+     return true;
 }
 
 /**
@@ -121,38 +551,35 @@ void HaCClientInfo::abort()
 {
      if(this->_soc)
      {
-          tcp_arg(this->_soc, NULL);
-          tcp_sent(this->_soc, NULL);
-          tcp_recv(this->_soc, NULL);
-          tcp_err(this->_soc, NULL);
-          tcp_poll(this->_soc, NULL, 0);  
+          this->_detach();
           tcp_abort(this->_soc);        
           this->_soc = nullptr;
+          //Aborted from a receive callback, lwIP has to be told
+          if(this->_receiving)
+               this->_receiveClosed = this->_receiveAborted = true;
      }
+     this->_endLinger(true);
+     this->_txQueue.clear(&HaCClientInfo::_onSendDone, this);
+
+     if(this->_linkFn)
+          this->_linkFn(this->_linkCtx, HAC_ERR_LOCAL_CLOSE);
 }
 
 /**
-     * Close connection  
+     * Close connection. Referenced data(See sendNoCopy and sendShared) lwIP already holds
+     * is still sent before the FIN, its buffers are released once acknowledged(See isDraining).
      * @param forceClose set to true if forcefully closing and aborting the socket connection  
      */
 void HaCClientInfo::close(bool forceClose) 
 {
-     if(this->socketState()!= CLOSED || forceClose)
+     //Nothing to close, the owner still has to stop what it has going
+     if(this->socketState() == CLOSED && !forceClose && !this->_resolving)
      {
-
-          tcp_close(this->_soc);  
-          //Dont delete the soc so that it can be recycled later on for future connection
-          /*if(this->_soc)
-          {
-               Serial.println(3);
-               this->_soc = nullptr;
-          }*/
-
-          if(this->_onClosedFn)
-               this->_onClosedFn(this);               
-          else 
-               delete this;
-     }          
+          if(this->_linkFn)
+               this->_linkFn(this->_linkCtx, HAC_ERR_LOCAL_CLOSE);
+          return;
+     }
+     this->_close(forceClose, false, true);
 }
 
 /**
@@ -180,6 +607,24 @@ void HaCClientInfo::getRemoteIP(char *bufferIP)
      strcpy(bufferIP, &(ip2.toString())[0]);     
 }
 
+/**
+     * Port of the remote end
+     * @return Remote port or 0 if not connected
+     */
+uint16_t HaCClientInfo::getRemotePort() const
+{
+     return this->_soc ? this->_soc->remote_port : 0;
+}
+
+/**
+     * Local port, tells which listener a server connection came in on
+     * @return Local port or 0 if not connected
+     */
+uint16_t HaCClientInfo::getLocalPort() const
+{
+     return this->_soc ? this->_soc->local_port : 0;
+}
+
 #ifdef ESP32  
 /**
      * Connect to remote server
@@ -190,14 +635,17 @@ void HaCClientInfo::getRemoteIP(char *bufferIP)
 bool HaCClientInfo::connect(const ip_addr_t *ip, uint16_t port) 
 {
      if(!this->_soc) return false;
-     //TO DO: Resolve host before proceeding
+     //Host names are resolved by connect(host, port)
      err_t err = tcp_connect(this->_soc, ip, port, &HaCClientInfo::_connected);
-     
 
      if (err != ERR_OK) {
-          Serial.println(3);
+          DBG_CB_HSOC2("\n[HACCLIENTINFO] Connect failed, err = %d\n", err);
           return false;
      }
+
+     this->_connecting = true;
+     this->_connectStartMs = millis();
+     this->_armTimer();
      
      return true;     
 }
@@ -213,91 +661,513 @@ bool HaCClientInfo::connect(const ip_addr_t *ip, uint16_t port)
 bool HaCClientInfo::connect(IPAddress ip, uint16_t port) 
 {
      if(!this->_soc) return false;
-     //TO DO: Resolve host before proceeding
-     
+     //Host names are resolved by connect(host, port)
      err_t err = tcp_connect(this->_soc, ip, port, &HaCClientInfo::_connected);
-     
 
      if (err != ERR_OK) {
-          Serial.println(3);
+          DBG_CB_HSOC2("\n[HACCLIENTINFO] Connect failed, err = %d\n", err);
           return false;
      }
+
+     this->_connecting = true;
+     this->_connectStartMs = millis();
+     this->_armTimer();
      
      return true;     
 }
 #endif
 
+/**
+     * Connect to remote server by host name, the name is resolved without blocking.
+     * The connect timeout applies to the lookup and then to the connection.
+     * @param host Host name or IP string
+     * @param port port of the remote host
+     * @return True if the lookup or the connection is started
+     */
+bool HaCClientInfo::connect(const char *host, uint16_t port) 
+{
+     if(!this->_soc || !host) return false;
+     if(this->_resolving) return true;
+
+     err_t err = HaCDnsCache::instance().resolve(host, &this->_resolvedIP, &HaCClientInfo::_onResolved, this);
+     if(err == ERR_OK)
+          return this->connect(&this->_resolvedIP, port);
+     if(err != ERR_INPROGRESS)
+     {
+          DBG_CB_HSOC("\n[HACCLIENTINFO] Host name can't be resolved..");
+          return false;
+     }
+
+     this->_resolving = true;
+     this->_resolvePort = port;
+     this->_connecting = true;
+     this->_connectStartMs = millis();
+     this->_armTimer();
+     
+     return true;     
+}
+
+/**
+     * Check if the host name given to connect is being resolved
+     * @return True while the lookup is running
+     */
+bool HaCClientInfo::isResolving() const
+{
+     return this->_resolving;
+}
+
+/**
+     * Check if a closed connection still waits for the remote end to acknowledge 
+     * referenced data(See sendNoCopy and sendShared), onBufferReleased fires once it does
+     * @return True while draining
+     */
+bool HaCClientInfo::isDraining() const
+{
+     return this->_lingerSoc != nullptr;
+}
+
 
 
 /**
      * onReceive Delegate function.           
      * @param fn onReceive Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
      */
-void HaCClientInfo::onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn) 
+bool HaCClientInfo::onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn) 
 {     
-     this->_onReceiveFn = fn;
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onReceive = fn;
+     return callbacks != nullptr;
+}
+
+/**
+     * onReceiveView Delegate function.
+     * The callback receives a read-only view over the whole pbuf chain, no copy is made.
+     * @param fn onReceiveView Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
+     */
+bool HaCClientInfo::onReceiveView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn) 
+{     
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onReceiveView = fn;
+     return callbacks != nullptr;
 }
 
 /**
      * onSent Delegate function.           
      * @param fn onSent Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
      */
-void HaCClientInfo::onSent(std::function<void(uint16_t, HaCClientInfo*)> fn) 
+bool HaCClientInfo::onSent(std::function<void(uint16_t, HaCClientInfo*)> fn) 
 {
-     this->_onSentFn = fn;
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onSent = fn;
+     return callbacks != nullptr;
 }
 
 /**
      * onError Delegate function.           
      * @param fn onError Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
      */
-void HaCClientInfo::onError(std::function<void(uint16_t, HaCClientInfo*)> fn) 
+bool HaCClientInfo::onError(std::function<void(uint16_t, HaCClientInfo*)> fn) 
 {
-     this->_onErrorFn = fn;
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onError = fn;
+     return callbacks != nullptr;
 }
 
 /**
      * onPoll Delegate function.           
      * @param fn onPoll Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
      */
-void HaCClientInfo::onPoll(std::function<void(HaCClientInfo*)> fn) 
+bool HaCClientInfo::onPoll(std::function<void(HaCClientInfo*)> fn) 
 {
-     this->_onPollFn = fn;
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onPoll = fn;
+     this->_applyPoll();
+     return callbacks != nullptr;
 }
 
 /**
      * onClosed Delegate function.           
      * @param fn onClosed Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
      */
-void HaCClientInfo::onClosed(std::function<void(HaCClientInfo*)> fn) 
+bool HaCClientInfo::onClosed(std::function<void(HaCClientInfo*)> fn) 
 {
-     this->_onClosedFn = fn;
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onClosed = fn;
+     return callbacks != nullptr;
 }
 
 /**
      * onConnected Delegate function.           
      * @param fn onClosed Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
+     */
+bool HaCClientInfo::onConnected(std::function<void(HaCClientInfo*)> fn) 
+{
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onConnected = fn;
+     return callbacks != nullptr;
+}
+
+/**
+     * onBufferReleased Delegate function.           
+     * Fired when a buffer given to sendNoCopy is acknowledged or dropped and can be reused.
+     * It may fire after onClosed, while the closed connection drains.
+     * @param fn onBufferReleased Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
+     */
+bool HaCClientInfo::onBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn) 
+{
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onBufferReleased = fn;
+     return callbacks != nullptr;
+}
+
+/**
+     * onWritable Delegate function.           
+     * Fired once the send queue drains down to the low watermark after reaching the high one.
+     * @param fn onWritable Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
+     */
+bool HaCClientInfo::onWritable(std::function<void(HaCClientInfo*)> fn) 
+{
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onWritable = fn;
+     return callbacks != nullptr;
+}
+
+/**
+     * onMessageSent Delegate function.           
+     * Fired once every byte of a message is acknowledged, with the time from send to acknowledge.
+     * @param fn onMessageSent Callback function
+     * @return False if the delegate can't be set(See setCallbacks)
+     */
+bool HaCClientInfo::onMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn) 
+{
+     HaCClientCallbacks *callbacks = this->_callbackTable();
+     if(callbacks)
+          callbacks->onMessageSent = fn;
+     return callbacks != nullptr;
+}
+
+/**
+     * Use a callback table shared with other connections instead of an own copy.
+     * The table is not copied and has to outlive the connection.
+     * With HAC_ENABLE_STATIC_MEMORY a connection without room for an own table(e.g. a pooled 
+     * server connection) keeps using the shared one, the delegate setters return false then.
+     * @param callbacks Shared callback table
+     */
+void HaCClientInfo::setCallbacks(const HaCClientCallbacks *callbacks) 
+{
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     delete this->_ownCallbacks;
+     #endif
+     this->_ownCallbacks = nullptr;
+     this->_callbacks = callbacks;
+     this->_applyPoll();
+}
+
+/**
+     * Check if received data is the busy frame of a full server(See HaCServer::setAdmissionPolicy)
+     * @param data Received data
+     * @param len Data length
+     * @param retryAfterMs Optional, receives the delay the server asks for before reconnecting
+     * @return True if the data is a busy frame
+     */
+bool HaCClientInfo::parseBusyFrame(const char *data, size_t len, uint32_t *retryAfterMs)
+{
+     size_t prefixLen = sizeof(HAC_BUSY_FRAME_PREFIX) - 1;
+     if(!data || len <= prefixLen || memcmp(data, HAC_BUSY_FRAME_PREFIX, prefixLen))
+          return false;
+
+     uint32_t ms = 0;
+     size_t i = prefixLen;
+     for(; i < len && data[i] >= '0' && data[i] <= '9'; i++)
+          ms = ms * 10 + (data[i] - '0');
+
+     //Text mode strips the line end
+     if(i == prefixLen || (i < len && data[i] != '\r' && data[i] != '\n' && data[i] != '\0'))
+          return false;
+
+     if(retryAfterMs)
+          *retryAfterMs = ms;
+     return true;
+}
+
+/**
+     * Give up a connect attempt(lookup included) after a while
+     * @param timeoutMs Time in ms, 0 for HAC_SOCCLIENT_CONNECT_TIMEOUT_MS
+     */
+void HaCClientInfo::setConnectTimeout(uint32_t timeoutMs)
+{
+     this->_connectTimeoutMs = timeoutMs ? timeoutMs : HAC_SOCCLIENT_CONNECT_TIMEOUT_MS;
+}
+
+/* #endregion */
+
+/* #region Protected */
+
+#ifdef HAC_ENABLE_STATIC_MEMORY
+/**
+     * Room for an own callback table, only owners that can afford it per connection give one
+     * @param storage Callback table kept as long as this object
+     */
+void HaCClientInfo::_setCallbackStorage(HaCClientCallbacks *storage)
+{
+     this->_ownCallbacksStorage = storage;
+}
+#endif
+
+/**
+     * Tell the owner of an outbound connection when it is up or down
+     * @param fn Called with ERR_OK once connected, with the reason otherwise, nullptr to stop
+     * @param ctx Passed back to fn
      */
-void HaCClientInfo::onConnected(std::function<void(HaCClientInfo*)> fn) 
+void HaCClientInfo::_setLinkFn(HaCLinkFn fn, void *ctx)
 {
-     this->_onConnectedFn = fn;
+     this->_linkFn = fn;
+     this->_linkCtx = ctx;
+}
+
+/**
+     * Check if a pcb is set up, there is none once the connection is gone
+     * @return True if a connection can be attempted on the current pcb
+     */
+bool HaCClientInfo::_hasSocket() const
+{
+     return this->_soc != nullptr;
 }
 
 /* #endregion */
 
 /* #region Private */
 
+/**
+     * Own callback table, created on the first delegate set on this connection.
+     * A shared table in use is copied so the other delegates are kept.
+     * With HAC_ENABLE_STATIC_MEMORY only an owner that gives the room has one(See HaCClient),
+     * pooled connections keep the delegates of their server.
+     * @return Own callback table or nullptr if there is no room for it
+     */
+HaCClientCallbacks* HaCClientInfo::_callbackTable()
+{
+     if(!this->_ownCallbacks)
+     {
+          #ifdef HAC_ENABLE_STATIC_MEMORY
+          if(!this->_ownCallbacksStorage)
+          {
+               DBG_CB_HSOC("[HACCLIENTINFO] No room for own delegates, the server's are kept!");
+               return nullptr;
+          }
+          this->_ownCallbacks = this->_ownCallbacksStorage;
+          *this->_ownCallbacks = this->_callbacks ? *this->_callbacks : HaCClientCallbacks();
+          #else
+          this->_ownCallbacks = this->_callbacks ? new HaCClientCallbacks(*this->_callbacks)
+                                                 : new HaCClientCallbacks();
+          #endif
+          this->_callbacks = this->_ownCallbacks;
+     }
+
+     return this->_ownCallbacks;
+}
+
+/**
+     * Apply the keepalive settings to the socket, a dead peer is then reported 
+     * by lwIP through the error callback
+     */
+void HaCClientInfo::_applyWatchdog()
+{
+     if(!this->_soc)
+          return;
+
+     if(this->_watchdogMode != HAC_WATCHDOG_KEEPALIVE)
+     {
+          this->_soc->so_options &= ~SOF_KEEPALIVE;
+          return;
+     }
+
+     this->_soc->so_options |= SOF_KEEPALIVE;
+     #if LWIP_TCP_KEEPALIVE
+     this->_soc->keep_idle = this->_keepAliveIdle;
+     this->_soc->keep_intvl = this->_keepAliveInterval;
+     this->_soc->keep_cnt = this->_keepAliveCount;
+     #endif
+}
+
 /**
      * Setup socket
      */
 void HaCClientInfo::_setup()
 { 
+     this->_endLinger(true);
+     this->_framer.reset();
+     this->_txQueue.clear(&HaCClientInfo::_onSendDone, this);
      tcp_setprio(this->_soc, TCP_PRIO_MIN);
      tcp_arg(this->_soc, this);
      tcp_recv(this->_soc, &HaCClientInfo::_onReceive);
      tcp_sent(this->_soc, &HaCClientInfo::_onSent);
      tcp_err(this->_soc, &HaCClientInfo::_onError);
-     tcp_poll(this->_soc, &HaCClientInfo::_onPoll, 1);   
+     this->_applyPoll();
+     this->_applyWatchdog();
+     this->setNoDelay(this->_noDelay);
+     this->_connecting = false;
+     this->_isRemoteEndNotOk = false;
+     this->_connectionNotOkCntr = 0;
+     this->_unconsumed = 0;
+     this->_withheld = 0;
+     this->_txAboveHigh = false;
+     this->_slowConsumer = false;
+     this->_lastAckMs = this->_lastReceiveMs = millis();
+     this->_armTimer();
+}
+
+/**
+     * Detach the socket callbacks from this object
+     */
+void HaCClientInfo::_detach()
+{ 
+     tcp_arg(this->_soc, NULL);
+     tcp_sent(this->_soc, NULL);
+     tcp_recv(this->_soc, NULL);
+     tcp_err(this->_soc, NULL);
+     tcp_poll(this->_soc, NULL, 0);  
+     HaCTimerWheel::instance().stop(&this->_timer);
+     if(this->_resolving)
+     {
+          this->_resolving = false;
+          HaCDnsCache::instance().cancel(this);
+     }
+}
+
+/**
+     * Close connection, this object may be deleted once it returns
+     * @param forceClose set to true if forcefully closing and aborting the socket connection  
+     * @param abortSocket set to true to reset the connection instead of a graceful close
+     * @param localClose set to true if the application asked for it
+     * @return True if the socket had to be aborted
+     */
+bool HaCClientInfo::_close(bool forceClose, bool abortSocket, bool localClose) 
+{
+     if(this->socketState() == CLOSED && !forceClose)
+          return false;
+
+     bool aborted = false;
+     if(this->_soc)
+     {
+          //No more callbacks once closed, the owner may delete this object
+          this->_detach();
+
+          //lwIP keeps the pcb after tcp_close in these states, it goes on sending what it holds
+          uint8_t state = this->_soc->state;
+          bool linger = !abortSocket && this->_txQueue.hasReferences() &&
+                        (state == ESTABLISHED || state == SYN_RCVD || state == CLOSE_WAIT);
+          if(linger)
+          {
+               this->_txQueue.truncate(&HaCClientInfo::_onSendDone, this);
+               //tcp_close resets the connection while received data isn't taken in
+               uint32_t held = this->_unconsumed + this->_withheld + this->_receiving;
+               while(held)
+               {
+                    uint16_t n = held > 0xFFFF ? 0xFFFF : (uint16_t)held;
+                    tcp_recved(this->_soc, n);
+                    held -= n;
+               }
+               this->_unconsumed = this->_withheld = 0;
+          }
+
+          //Closed from a receive callback, the data being delivered is taken in
+          if(this->_receiving && !abortSocket && !linger)
+               tcp_recved(this->_soc, this->_receiving);
+
+          if(abortSocket || tcp_close(this->_soc) != ERR_OK)
+          {
+               tcp_abort(this->_soc);
+               aborted = true;
+          }
+          //Referenced buffers lwIP still reads from are released once acknowledged
+          else if(linger && this->_txQueue.hasReferences())
+               this->_linger(this->_soc);
+          //lwIP frees the pcb once it is closed, a new connection needs a new one
+          this->_soc = nullptr;
+          //The receive callback stops delivering and reports the close to lwIP
+          if(this->_receiving)
+          {
+               this->_receiveClosed = true;
+               this->_receiveAborted = aborted;
+          }
+     }
+     if(!this->_lingerSoc)
+          this->_txQueue.clear(&HaCClientInfo::_onSendDone, this);
+
+     if(this->_callbacks && this->_callbacks->onClosed)
+          this->_callbacks->onClosed(this);               
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     //Kept by its owner until told the connection is down
+     else if(!this->_linkFn)
+     {
+          //Deleted once lwIP is done with the referenced buffers
+          if(this->_lingerSoc)
+               this->_lingerDelete = true;
+          //Still in use by the receive callback, deleted when it returns
+          else if(this->_receiving)
+               this->_receiveDelete = true;
+          else
+               delete this;
+          return aborted;
+     }
+     #endif
+     if(this->_linkFn)
+          this->_linkFn(this->_linkCtx, localClose ? HAC_ERR_LOCAL_CLOSE : (err_t)(aborted ? ERR_ABRT : ERR_CLSD));
+
+     return aborted;
+}
+
+/**
+     * Keep a gracefully closed pcb until the remote end acknowledges the referenced data 
+     * lwIP still sends from, only the sent and error callbacks stay on
+     * @param soc Closed socket
+     */
+void HaCClientInfo::_linger(tcp_pcb *soc)
+{
+     this->_lingerSoc = soc;
+     //The owner may reset the callbacks of a closed connection(e.g. a pooled slot)
+     this->_lingerReleasedFn = this->_callbacks ? this->_callbacks->onBufferReleased : nullptr;
+     tcp_arg(soc, this);
+     tcp_sent(soc, &HaCClientInfo::_onLingerSent);
+     tcp_err(soc, &HaCClientInfo::_onLingerError);
+}
+
+/**
+     * Stop draining the closed pcb and release what is left on the send queue
+     * @param abortSocket set to true to reset the pcb, lwIP still holds it
+     */
+void HaCClientInfo::_endLinger(bool abortSocket)
+{
+     if(this->_lingerSoc)
+     {
+          tcp_arg(this->_lingerSoc, NULL);
+          tcp_sent(this->_lingerSoc, NULL);
+          tcp_err(this->_lingerSoc, NULL);
+          if(abortSocket)
+               tcp_abort(this->_lingerSoc);
+          this->_lingerSoc = nullptr;
+          this->_txQueue.clear(&HaCClientInfo::_onLingerDone, this);
+     }
+     this->_lingerReleasedFn = nullptr;
 }
 /**
      * Internal library Calback function for on receive
@@ -313,48 +1183,123 @@ err_t HaCClientInfo::_onReceive(struct tcp_pcb *tpcb,
      if(p == 0) //Client close connection
      {
           Serial.println("\n[HACCLIENTINFO] Close...");          
-          this->close(true);
-          return ERR_CLSD;
+          return this->_close(true) ? ERR_ABRT : ERR_CLSD;
      }
      /*
      this->_totalBytesReceive += p->tot_len;
      Serial.printf("\n Receive : p->len = %d p->tot_len = %d _totalBytesReceive = %llu err = %llu", 
                     p->len, p->tot_len, _totalBytesReceive, err);
      */
-     if(this->_onReceiveFn)
+     uint16_t totalLen = p->tot_len;
+     const HaCClientCallbacks *cb = this->_callbacks;
+     this->_lastReceiveMs = millis();
+     this->_isRemoteEndNotOk = false;
+     this->_connectionNotOkCntr = 0;
+     //A callback may close the connection, see _receiveClosed
+     this->_receiving = totalLen;
+     this->_receiveClosed = this->_receiveAborted = this->_receiveDelete = false;
+
+     if(cb && cb->onReceiveView)
+          cb->onReceiveView(this, HaCPbufView(p));
+
+     bool hasReceive = cb && cb->onReceive && !this->_receiveClosed;
+     if(hasReceive && this->_receiveMode == HAC_RX_MODE_BINARY)
+     {
+          //Binary safe, each segment is delivered as is with its exact length
+          for(pbuf *q = p; q && !this->_receiveClosed; q = q->next)
+          {
+               if(q->len)
+                    cb->onReceive(this, (const char*)q->payload, q->len, totalLen);
+          }
+     }
+     else if(hasReceive && (this->_receiveMode == HAC_RX_MODE_DELIMITED || 
+                            this->_receiveMode == HAC_RX_MODE_LENGTH_PREFIXED))
+     {
+          for(pbuf *q = p; q && !this->_receiveClosed; q = q->next)
+          {
+               //Stream can't be framed anymore, drop the connection
+               if(!this->_framer.feed((const uint8_t*)q->payload, q->len, &HaCClientInfo::_onFrame, this))
+                    this->_close(true);
+          }
+     }
+     else if(hasReceive)
      {
-          //TO DO: Manage chunk packet
-          const char *s = (const char*)p->payload;
-          char *buffer = new char[p->tot_len + 1];
-          memset(buffer, '\0', p->tot_len + 1);
+          #ifdef HAC_ENABLE_STATIC_MEMORY
+          //One buffer for every connection, lwIP delivers to one connection at a time
+          static char buffer[HAC_SOCCLIENT_RX_TEXT_SIZE + 1];
+          const uint16_t capacity = HAC_SOCCLIENT_RX_TEXT_SIZE;
+          #else
+          char *buffer = new char[totalLen + 1];
+          const uint16_t capacity = totalLen;
+          #endif
          
           uint16_t i = 0;
-          while(*s)
-          {    
-               if(_ignoreCRNLReceiveData)// Ignore carriage return and newline character
+          bool isEnd = false;
+          for(pbuf *q = p; q && !isEnd; q = q->next)
+          {
+               const char *s = (const char*)q->payload;
+               for(uint16_t j = 0; j < q->len; j++, s++)
                {
-                    if(*s != '\n' && *s != '\r')
-                         buffer[i++] = *s;
-               }
-               else
+                    if(!*s)
+                    {
+                         isEnd = true;
+                         break;
+                    }
+
+                    if(_ignoreCRNLReceiveData && (*s == '\n' || *s == '\r'))// Ignore carriage return and newline character
+                         continue;
+
+                    if(i >= capacity)
+                    {
+                         //Buffer is full, deliver what is there and go on with the rest
+                         buffer[i] = '\0';
+                         cb->onReceive(this, &buffer[0], i, totalLen);
+                         i = 0;
+                         if(this->_receiveClosed)
+                         {
+                              isEnd = true;
+                              break;
+                         }
+                    }
                     buffer[i++] = *s;
-               
-               s++;             
-               if(i >= p->tot_len) break; 
+               }
           }
-          buffer[i++] = '\0';
+          buffer[i] = '\0';
 
-          if(buffer[0])
+          if(buffer[0] && !this->_receiveClosed)
           {
-               this->_onReceiveFn(this, &buffer[0], p->len, p->tot_len);
+               cb->onReceive(this, &buffer[0], i, totalLen);
           }
+          #ifndef HAC_ENABLE_STATIC_MEMORY
           delete[] buffer;
+          #endif
      }
 
 
      pbuf_free(p);     
-     if(tpcb)
-            tcp_recved(tpcb, p->tot_len);     
+     this->_receiving = 0;
+     if(this->_receiveClosed)
+     {
+          //Closed from a callback, the pcb is not this connection's anymore
+          bool aborted = this->_receiveAborted;
+          #ifndef HAC_ENABLE_STATIC_MEMORY
+          if(this->_receiveDelete)
+               delete this;
+          #endif
+          return aborted ? ERR_ABRT : ERR_OK;
+     }
+
+     //Manual window, the sender is held back until the application calls consume
+     if(this->_manualReceiveWindow)
+          this->_unconsumed += totalLen;
+     else if(this->_withheld || !HaCMemoryGovernor::instance().canReceive())
+     {
+          //Heap is low, the window is reopened from the timer once it recovers
+          this->_withheld += totalLen;
+          this->_armTimer();
+     }
+     else if(tpcb)
+            tcp_recved(tpcb, totalLen);     
 
      return ERR_OK;
 }
@@ -369,8 +1314,22 @@ err_t HaCClientInfo::_onSent(struct tcp_pcb *tpcb,
                               u16_t len)
 {
      this->_isRemoteEndNotOk = false;
-     if(this->_onSentFn)
-          this->_onSentFn(len, this);
+     this->_connectionNotOkCntr = 0;
+     this->_lastAckMs = millis();
+
+     //Release the acknowledged data and resume the queued data
+     this->_txQueue.acked(len, &HaCClientInfo::_onSendDone, this);
+     this->_txQueue.flush(tpcb);
+
+     if(this->_callbacks && this->_callbacks->onSent)
+          this->_callbacks->onSent(len, this);
+
+     if(this->_txAboveHigh && this->_soc && this->_txQueue.pendingBytes() <= this->_txLowWatermark)
+     {
+          this->_txAboveHigh = false;
+          if(this->_callbacks && this->_callbacks->onWritable)
+               this->_callbacks->onWritable(this);
+     }
 
      return ERR_OK;
 }
@@ -381,9 +1340,53 @@ err_t HaCClientInfo::_onSent(struct tcp_pcb *tpcb,
      */
 void HaCClientInfo::_onError(err_t err)
 {
-     Serial.printf("\n[HACCLIENTINFO] Error %d \n", this->_connectionId);     
-     if(this->_onErrorFn)
-          this->_onErrorFn((uint32_t)err, this);    
+     DBG_CB_HSOC2("\n[HACCLIENTINFO] Error %lu \n", (unsigned long)this->_connectionId);     
+     //Socket is already freed by lwIP(e.g. reset or keepalive timeout)
+     this->_soc = nullptr;
+     this->_connecting = false;
+     HaCTimerWheel::instance().stop(&this->_timer);
+     this->_txQueue.clear(&HaCClientInfo::_onSendDone, this);
+     if(this->_callbacks && this->_callbacks->onError)
+          this->_callbacks->onError((uint32_t)err, this);    
+
+     //The connection is gone, let the owner recycle it
+     if(this->_callbacks && this->_callbacks->onClosed)
+          this->_callbacks->onClosed(this);
+     if(this->_linkFn)
+          this->_linkFn(this->_linkCtx, err);
+}
+
+/**
+     * Referenced data of a closed connection acknowledged
+     * @param len Number of bytes acknowledged
+     */
+void HaCClientInfo::_onLingerSent(u16_t len)
+{
+     this->_txQueue.acked(len, &HaCClientInfo::_onLingerDone, this);
+     if(this->_txQueue.hasReferences())
+          return;
+
+     //lwIP finishes the close by itself
+     this->_endLinger(false);
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     if(this->_lingerDelete)
+          delete this;
+     #endif
+}
+
+/**
+     * Closed connection reset before its referenced data was acknowledged
+     */
+void HaCClientInfo::_onLingerError()
+{
+     //Socket is already freed by lwIP
+     this->_lingerSoc = nullptr;
+     this->_txQueue.clear(&HaCClientInfo::_onLingerDone, this);
+     this->_lingerReleasedFn = nullptr;
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     if(this->_lingerDelete)
+          delete this;
+     #endif
 }
 
 /**
@@ -393,13 +1396,72 @@ void HaCClientInfo::_onError(err_t err)
      */
 err_t HaCClientInfo::_onPoll(struct tcp_pcb *tpcb)
 {
+     //Timers stop for good if lwIP couldn't schedule their tick
+     HaCTimerWheel::instance().check();
+
+     if(this->_callbacks && this->_callbacks->onPoll)
+          this->_callbacks->onPoll(this);    
+
+     return ERR_OK;
+}
+
+/**
+     * Connection timer, handles the connect timeout, the idle timeout and the ping watchdog
+     */
+void HaCClientInfo::_onTimer()
+{
+     if(this->_slowConsumer)
+     {
+          DBG_CB_HSOC("\n[HACCLIENTINFO] Slow consumer or broken stream disconnected..");
+          this->_close(true, true);
+          return;
+     }
+
+     if(this->_withheld && HaCMemoryGovernor::instance().canReceive())
+     {
+          DBG_CB_HSOC("\n[HACCLIENTINFO] Heap recovered, receive window reopened..");
+          uint32_t len = this->_withheld;
+          this->_withheld = 0;
+          while(len)
+          {
+               uint16_t chunk = len > 0xFFFF ? 0xFFFF : (uint16_t)len;
+               tcp_recved(this->_soc, chunk);
+               len -= chunk;
+          }
+     }
+
+     uint32_t now = millis();
+     if(this->_connecting)
+     {
+          if(now - this->_connectStartMs < this->_connectTimeoutMs)
+          {
+               this->_armTimer();
+               return;
+          }
+
+          DBG_CB_HSOC("\n[HACCLIENTINFO] Connect timeout..");
+          this->_connecting = false;
+          if(this->_callbacks && this->_callbacks->onError)
+               this->_callbacks->onError((uint16_t)ERR_TIMEOUT, this);
+          this->_close(true, true);
+          return;
+     }
+
+     uint32_t idleMs = now - this->_lastActivityMillis();
+     if(this->_idleTimeoutMs && idleMs >= this->_idleTimeoutMs)
+     {
+          DBG_CB_HSOC("\n[HACCLIENTINFO] Idle timeout..");
+          this->_close(true);
+          return;
+     }
 
-     if(this->_pollingCounter > HAC_SOCCLIENT_POLL_INTVAL_PING && this->_enablePingWatchdog)
+     //Acks or data within the idle time prove the peer is alive, no probe needed
+     uint32_t sinceMs = this->_isRemoteEndNotOk ? now - this->_probeMs : idleMs;
+     if(this->_watchdogMode == HAC_WATCHDOG_PING && sinceMs >= HAC_SOCCLIENT_PING_IDLE_MS)
      {
-          this->_pollingCounter = 0;
-          long err = this->sendData("ping");
+          long err = this->_sendPing();
           tcp_output(this->_soc);
-          Serial.printf("\n[HACCLIENTINFO] Send Err = %lu this->_connectionNotOkCntr = %d this->_isSendingPing = %d \n",
+          DBG_CB_HSOC2("\n[HACCLIENTINFO] Send Err = %ld this->_connectionNotOkCntr = %d this->_isSendingPing = %d \n",
                err, this->_connectionNotOkCntr, this->_isRemoteEndNotOk);
 
           //If the sendData can't be acknowledge via the onSent event then isRemoteEndNotOk will
@@ -411,30 +1473,191 @@ err_t HaCClientInfo::_onPoll(struct tcp_pcb *tpcb)
 
           if(this->_connectionNotOkCntr >= 2 || err != ERR_OK)
           {
-               Serial.printf("\n[HACCLIENTINFO] Remote Client Closed connection...\n");
-               tcp_output(this->_soc);
-               this->close();
+               DBG_CB_HSOC2("\n[HACCLIENTINFO] Remote Client Closed connection...\n");
 
-               //This kind of connection error need to close the soc so that the next 
-               //connection attempt will be fresh
-
-               this->abort();
-
-               return ERR_CLSD;
+               //This kind of connection error need to reset the soc so that the next 
+               //connection attempt will be fresh, this object may be recycled once it returns
+               this->_close(true, true);
+               return;
           }
           //On Sent event wil toggle this bit to false, if the sendData won't get
           //any reply via onSent event means there is a problem on the remote end..
           this->_isRemoteEndNotOk = true;
+          this->_probeMs = now;
      }
-     this->_pollingCounter++;
 
+     this->_armTimer();
+}
+
+/**
+     * Schedule the connection timer for the nearest deadline, lwIP is not polled per connection.
+     * Traffic doesn't touch the timer, it is checked again when the timer expires.
+     */
+void HaCClientInfo::_armTimer()
+{
+     HaCTimerWheel &wheel = HaCTimerWheel::instance();
+     if(!this->_soc || (!this->_connecting && this->_soc->state < ESTABLISHED))
+     {
+          wheel.stop(&this->_timer);
+          return;
+     }
 
-     if(this->_onPollFn)
-          this->_onPollFn(this);    
+     uint32_t now = millis();
+     uint32_t dueMs = UINT32_MAX;
+     if(this->_slowConsumer)
+          dueMs = 0;
+     else if(this->_connecting)
+     {
+          uint32_t elapsed = now - this->_connectStartMs;
+          dueMs = elapsed >= this->_connectTimeoutMs ? 0 : this->_connectTimeoutMs - elapsed;
+     }
+     else
+     {
+          uint32_t idleMs = now - this->_lastActivityMillis();
+          if(this->_idleTimeoutMs)
+               dueMs = idleMs >= this->_idleTimeoutMs ? 0 : this->_idleTimeoutMs - idleMs;
+
+          if(this->_watchdogMode == HAC_WATCHDOG_PING)
+          {
+               uint32_t sinceMs = this->_isRemoteEndNotOk ? now - this->_probeMs : idleMs;
+               uint32_t pingMs = sinceMs >= HAC_SOCCLIENT_PING_IDLE_MS ? 0 : HAC_SOCCLIENT_PING_IDLE_MS - sinceMs;
+               if(pingMs < dueMs)
+                    dueMs = pingMs;
+          }
+     }
+
+     if(this->_withheld && dueMs > HAC_HEAP_RECHECK_MS)
+          dueMs = HAC_HEAP_RECHECK_MS;
+
+     if(dueMs == UINT32_MAX)
+          wheel.stop(&this->_timer);
+     else
+          wheel.start(&this->_timer, dueMs, &HaCClientInfo::_onTimer, this);
+}
+
+/**
+     * Time of the last ack or received data, whichever is later
+     * @return millis() of the last activity
+     */
+uint32_t HaCClientInfo::_lastActivityMillis() const
+{
+     return (int32_t)(this->_lastAckMs - this->_lastReceiveMs) > 0 ? this->_lastAckMs : this->_lastReceiveMs;
+}
+
+/**
+     * Register the lwIP poll callback only if there is an onPoll callback to raise
+     */
+void HaCClientInfo::_applyPoll()
+{
+     if(!this->_soc)
+          return;
+
+     if(this->_callbacks && this->_callbacks->onPoll)
+          tcp_poll(this->_soc, &HaCClientInfo::_onPoll, 1);
+     else
+          tcp_poll(this->_soc, NULL, 0);
+}
+
+/**
+     * Report the token of a queued message and transmit it right away if Nagle is off
+     * @param err Send queue result
+     * @param token Optional, receives the message token
+     * @return Send queue result
+     */
+err_t HaCClientInfo::_queued(err_t err, HaCMessageToken *token)
+{
+     //A message was cut on the wire, the caller may be inside a callback so it is dropped from the timer
+     if(err == ERR_ABRT)
+     {
+          this->_slowConsumer = true;
+          this->_armTimer();
+     }
+     if(err != ERR_OK)
+          return err;
+
+     if(token)
+          *token = this->_txQueue.lastToken();
+
+     if(this->_noDelay && !this->_txQueue.isCorked())
+          tcp_output(this->_soc);
 
      return ERR_OK;
 }
 
+/**
+     * Queue the watchdog ping, it gets no message token so onMessageSent isn't fired for it.
+     * The slow consumer policy is for application data and doesn't apply, data that already 
+     * waits for an ack probes the remote end as well as a ping would.
+     * @return Send queue result
+     */
+err_t HaCClientInfo::_sendPing()
+{
+     if(!this->_txQueue.isEmpty())
+          return ERR_OK;
+
+     return this->_txQueue.push(this->_soc, (const uint8_t*)"ping", 4, true, false);
+}
+
+/**
+     * Apply the slow consumer policy if new data would take the connection over its high watermark
+     * @param len Number of bytes to be queued
+     * @return ERR_OK if the data can be queued, ERR_MEM if it is dropped, ERR_ABRT if the connection is being dropped
+     */
+err_t HaCClientInfo::_admit(uint32_t len)
+{
+     if(this->_slowConsumer)
+          return ERR_ABRT;
+
+     uint32_t pending = this->_txQueue.pendingBytes();
+     if(!this->_txHighWatermark || pending + len <= this->_txHighWatermark)
+          return ERR_OK;
+
+     this->_txAboveHigh = true;
+     switch(this->_slowConsumerPolicy)
+     {
+          case HAC_SLOW_CONSUMER_DROP_OLDEST:
+               this->_txQueue.dropUnwritten(pending + len - this->_txHighWatermark, &HaCClientInfo::_onSendDone, this);
+               if(this->_txQueue.pendingBytes() + len <= this->_txHighWatermark)
+                    return ERR_OK;
+               return ERR_MEM;
+
+          case HAC_SLOW_CONSUMER_DISCONNECT:
+               //The caller may be inside a callback of this connection, close from the timer
+               DBG_CB_HSOC("\n[HACCLIENTINFO] Slow consumer..");
+               this->_slowConsumer = true;
+               this->_armTimer();
+               return ERR_ABRT;
+
+          default:
+               return ERR_MEM;
+     }
+}
+
+/**
+     * Host name resolved, start the connection
+     * @param ip Address or nullptr if the lookup failed
+     */
+void HaCClientInfo::_onResolved(const ip_addr_t *ip)
+{
+     this->_resolving = false;
+     this->_connecting = false;
+     HaCTimerWheel::instance().stop(&this->_timer);
+
+     if(ip)
+     {
+          this->_resolvedIP = *ip;
+          if(this->connect(&this->_resolvedIP, this->_resolvePort))
+               return;
+     }
+
+     DBG_CB_HSOC("\n[HACCLIENTINFO] Connect failed..");
+     err_t err = ip ? ERR_CONN : ERR_VAL;
+     if(this->_callbacks && this->_callbacks->onError)
+          this->_callbacks->onError((uint16_t)err, this);
+     if(this->_linkFn)
+          this->_linkFn(this->_linkCtx, err);
+}
+
 /**
      * Internal library Calback function for connected
      * @param pcb Socket pointer
@@ -444,12 +1667,64 @@ err_t HaCClientInfo::_onPoll(struct tcp_pcb *tpcb)
 
 err_t HaCClientInfo::_connected(struct tcp_pcb *pcb, err_t err)
 {
-    if(this->_onConnectedFn)
-        this->_onConnectedFn(this);
+    this->_connecting = false;
+    this->_lastAckMs = this->_lastReceiveMs = millis();
+    this->_armTimer();
+
+    if(this->_callbacks && this->_callbacks->onConnected)
+        this->_callbacks->onConnected(this);
+    if(this->_linkFn)
+        this->_linkFn(this->_linkCtx, ERR_OK);
     
     return ERR_OK;
 }
 
+/**
+     * Framer Calback function for every complete frame
+     * @param ctx HaCClientInfo pointer
+     * @param frame Frame data
+     * @param len Frame length
+     * @return False once the connection is closed, the rest is not delivered
+     */
+bool HaCClientInfo::_onFrame(void *ctx, const uint8_t *frame, uint16_t len)
+{
+    HaCClientInfo *self = reinterpret_cast<HaCClientInfo*>(ctx);
+    //A pooled slot loses its callbacks when closed
+    if(self->_receiveClosed || !self->_callbacks || !self->_callbacks->onReceive)
+        return false;
+
+    self->_callbacks->onReceive(self, (const char*)frame, len, len);
+    return !self->_receiveClosed;
+}
+
+/**
+     * Send queue Calback function for every acknowledged or dropped message
+     * @param ctx HaCClientInfo pointer
+     * @param entry Send queue entry
+     */
+void HaCClientInfo::_onSendDone(void *ctx, const HaCSendEntry &entry)
+{
+    HaCClientInfo *self = reinterpret_cast<HaCClientInfo*>(ctx);
+    if(entry.data && !entry.shared && self->_callbacks && self->_callbacks->onBufferReleased)
+        self->_callbacks->onBufferReleased(self, entry.data);
+
+    //Dropped messages are not reported, only the ones acknowledged in full
+    if(entry.token && entry.acked == entry.len && self->_callbacks && self->_callbacks->onMessageSent)
+        self->_callbacks->onMessageSent(self, entry.token, millis() - entry.queuedMs);
+}
+
+/**
+     * Send queue Calback function of a closed connection, only the buffers are reported
+     * @param ctx HaCClientInfo pointer
+     * @param entry Released buffer
+     */
+void HaCClientInfo::_onLingerDone(void *ctx, const HaCSendEntry &entry)
+{
+    HaCClientInfo *self = reinterpret_cast<HaCClientInfo*>(ctx);
+    if(entry.data && !entry.shared && self->_lingerReleasedFn)
+        self->_lingerReleasedFn(self, entry.data);
+}
+
 /**
      * Native library Calback function for on receive
      * @param arg General Pointer
@@ -476,6 +1751,16 @@ err_t HaCClientInfo::_onSent(void *arg, struct tcp_pcb *tpcb,
     return reinterpret_cast<HaCClientInfo*>(arg)->_onSent(tpcb, len); 
 }
 
+/**
+     * DNS cache callback
+     * @param ctx Client connection
+     * @param ip Address or nullptr if the lookup failed
+     */
+void HaCClientInfo::_onResolved(void *ctx, const ip_addr_t *ip)
+{
+    reinterpret_cast<HaCClientInfo*>(ctx)->_onResolved(ip); 
+}
+
 /**
      * Native library Calback function for on error
      * @param arg General Pointer
@@ -486,6 +1771,29 @@ void HaCClientInfo::_onError(void *arg, err_t err)
     reinterpret_cast<HaCClientInfo*>(arg)->_onError(err); 
 }
 
+/**
+     * Native library Calback function for on sent of a closed connection
+     * @param arg General Pointer
+     * @param tpcp Socket pointer
+     * @param len Number of bytes acknowledged
+     * @return Socket error state
+     */
+err_t HaCClientInfo::_onLingerSent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+    reinterpret_cast<HaCClientInfo*>(arg)->_onLingerSent(len);
+    return ERR_OK;
+}
+
+/**
+     * Native library Calback function for on error of a closed connection
+     * @param arg General Pointer
+     * @param err Socket error state
+     */
+void HaCClientInfo::_onLingerError(void *arg, err_t err)
+{
+    reinterpret_cast<HaCClientInfo*>(arg)->_onLingerError(); 
+}
+
 /**
      * Native library Calback function for on poll
      * @param arg General Pointer
@@ -497,6 +1805,15 @@ err_t HaCClientInfo::_onPoll(void *arg, struct tcp_pcb *tpcb)
     return reinterpret_cast<HaCClientInfo*>(arg)->_onPoll(tpcb); 
 }
 
+/**
+     * Timer wheel Calback function
+     * @param ctx HaCClientInfo pointer
+     */
+void HaCClientInfo::_onTimer(void *ctx)
+{
+    reinterpret_cast<HaCClientInfo*>(ctx)->_onTimer(); 
+}
+
 /**
      * Native library Calback function for connected
      * @param arg General Pointer
@@ -35,6 +35,12 @@
 
 /* #region INTERNAL_DEPENDENCY */
 #include "HaCEspSockets.h"
+#include "HaCPbufView.h"
+#include "HaCFramer.h"
+#include "HaCSendQueue.h"
+#include "HaCTimerWheel.h"
+#include "HaCMemoryGovernor.h"
+#include "HaCDnsCache.h"
 /* #endregion */
 
 /* #region EXTERNAL_DEPENDENCY */
@@ -48,6 +54,120 @@
 
 /* #region GLOBAL_DECLARATION */
 #define HAC_SOCCLIENT_POLL_INTVAL_PING 10
+
+#ifndef HAC_SOCCLIENT_CONNECT_TIMEOUT_MS
+#define HAC_SOCCLIENT_CONNECT_TIMEOUT_MS    10000
+#endif
+
+#ifndef HAC_SOCCLIENT_PING_IDLE_MS
+#define HAC_SOCCLIENT_PING_IDLE_MS      (HAC_SOCCLIENT_POLL_INTVAL_PING * 500)   //No ack or data for this long before the ping watchdog probes
+#endif
+
+#ifndef HAC_KEEPALIVE_DEF_IDLE
+#define HAC_KEEPALIVE_DEF_IDLE          30000   //ms without traffic before the first keepalive probe
+#endif
+
+#ifndef HAC_KEEPALIVE_DEF_INTERVAL
+#define HAC_KEEPALIVE_DEF_INTERVAL      5000    //ms between unanswered probes
+#endif
+
+#ifndef HAC_KEEPALIVE_DEF_COUNT
+#define HAC_KEEPALIVE_DEF_COUNT         3       //Unanswered probes before the connection is dropped
+#endif
+
+#ifndef HAC_SOCCLIENT_RX_TEXT_SIZE
+#define HAC_SOCCLIENT_RX_TEXT_SIZE      256     //Text receive buffer with HAC_ENABLE_STATIC_MEMORY, longer data comes in chunks
+#endif
+
+#ifndef HAC_SOCCLIENT_TX_HIGH_WATERMARK
+#define HAC_SOCCLIENT_TX_HIGH_WATERMARK 0       //Unacknowledged bytes before a connection is a slow consumer, 0 to disable
+#endif
+
+#ifndef HAC_BUSY_FRAME_PREFIX
+#define HAC_BUSY_FRAME_PREFIX           "busy retry="   //Frame sent by a full server, followed by the retry delay in ms and \n
+#endif
+
+/**
+     * Connection handle
+     * Low 8 bits are the pool slot, upper 24 bits the slot generation so a handle 
+     * of a closed connection never matches the connection that reuses its slot.
+     */
+typedef uint32_t HaCConnectionHandle;
+#define HAC_CONNECTION_HANDLE_INVALID   0
+#define HAC_CONNECTION_HANDLE_SLOT_BITS 8
+#define HAC_CONNECTION_HANDLE_SLOT(h)   ((uint8_t)((h) & 0xFF))
+#define HAC_CONNECTION_HANDLE_GEN(h)    ((uint32_t)(h) >> HAC_CONNECTION_HANDLE_SLOT_BITS)
+
+/**
+     * Connection up or down, told to the owner of an outbound connection(See HaCClient)
+     * err is ERR_OK once connected, otherwise the reason the connection or the attempt ended,
+     * HAC_ERR_LOCAL_CLOSE when the application closed or aborted it itself
+     */
+typedef void (*HaCLinkFn)(void *ctx, err_t err);
+#define HAC_ERR_LOCAL_CLOSE     ((err_t)-64)
+
+/**
+     * Receive data mode
+     * HAC_RX_MODE_TEXT : NUL terminated string with CR/LF removed(Default)
+     * HAC_RX_MODE_BINARY : Raw bytes of each pbuf segment with its exact length
+     * HAC_RX_MODE_DELIMITED : One callback per complete delimited message(See setLineFraming)
+     * HAC_RX_MODE_LENGTH_PREFIXED : One callback per complete length prefixed frame(See setLengthPrefixFraming)
+     */
+enum HaCReceiveMode : uint8_t
+{
+    HAC_RX_MODE_TEXT = 0,
+    HAC_RX_MODE_BINARY,
+    HAC_RX_MODE_DELIMITED,
+    HAC_RX_MODE_LENGTH_PREFIXED
+};
+
+/**
+     * Dead peer detection
+     * HAC_WATCHDOG_OFF : No liveness check
+     * HAC_WATCHDOG_PING : "ping" sent on the data stream after HAC_SOCCLIENT_PING_IDLE_MS without traffic(Default)
+     * HAC_WATCHDOG_KEEPALIVE : TCP keepalive probes, nothing is added to the data stream
+     */
+enum HaCWatchdogMode : uint8_t
+{
+    HAC_WATCHDOG_OFF = 0,
+    HAC_WATCHDOG_PING,
+    HAC_WATCHDOG_KEEPALIVE
+};
+
+/**
+     * What to do with new data once a connection reaches its send high watermark
+     * HAC_SLOW_CONSUMER_DROP_NEWEST : The new data is refused with ERR_MEM(Default)
+     * HAC_SLOW_CONSUMER_DROP_OLDEST : Queued messages not yet written to the socket are dropped to make room
+     * HAC_SLOW_CONSUMER_DISCONNECT : The connection is aborted on the next timer tick
+     */
+enum HaCSlowConsumerPolicy : uint8_t
+{
+    HAC_SLOW_CONSUMER_DROP_NEWEST = 0,
+    HAC_SLOW_CONSUMER_DROP_OLDEST,
+    HAC_SLOW_CONSUMER_DISCONNECT
+};
+
+class HaCClientInfo;
+
+/**
+     * Connection callback table
+     * One table can be shared by any number of connections(e.g. every connection of a server),
+     * so the delegates are stored once instead of being copied into each connection.
+     */
+struct HaCClientCallbacks
+{
+    std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> onReceive;
+    std::function<void(HaCClientInfo*, const HaCPbufView&)> onReceiveView;
+    std::function<void(uint16_t, HaCClientInfo*)> onSent;
+    std::function<void(uint16_t, HaCClientInfo*)> onError;
+    std::function<void(HaCClientInfo*)> onPoll;
+    std::function<void(HaCClientInfo*)> onClosed;
+    std::function<void(HaCClientInfo*, tcp_pcb*)> onAccepted;
+    std::function<void(HaCClientInfo*)> onConnected;
+    std::function<void(HaCClientInfo*, const void*)> onBufferReleased;
+    std::function<void(HaCClientInfo*)> onWritable;
+    std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> onMessageSent;
+};
 /* #endregion */
 
 /* #region CLASS_DECLARATION */
@@ -57,49 +177,148 @@ class HaCClientInfo
         HaCClientInfo();
         HaCClientInfo(tcp_pcb* pcb, std::function<void(HaCClientInfo*, tcp_pcb*)> fn);
         ~HaCClientInfo();
-        void onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn);
-        void onSent(std::function<void(uint16_t, HaCClientInfo*)> fn);
-        void onError(std::function<void(uint16_t, HaCClientInfo*)> fn);
-        void onPoll(std::function<void(HaCClientInfo*)> fn);
-        void onClosed(std::function<void(HaCClientInfo*)> fn);        
-        void onConnected(std::function<void(HaCClientInfo*)> fn);  
-        void setConnectionId(uint8_t id);
-        uint8_t getConnectionId();
+        //False if not set, a pooled server connection built with HAC_ENABLE_STATIC_MEMORY only uses its server delegates
+        bool onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn);
+        bool onReceiveView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn);
+        bool onSent(std::function<void(uint16_t, HaCClientInfo*)> fn);
+        bool onError(std::function<void(uint16_t, HaCClientInfo*)> fn);
+        bool onPoll(std::function<void(HaCClientInfo*)> fn);
+        bool onClosed(std::function<void(HaCClientInfo*)> fn);        
+        bool onConnected(std::function<void(HaCClientInfo*)> fn);  
+        bool onBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn);
+        bool onWritable(std::function<void(HaCClientInfo*)> fn);
+        bool onMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn);
+        void setCallbacks(const HaCClientCallbacks *callbacks);
+        void setConnectionId(HaCConnectionHandle id);
+        HaCConnectionHandle getConnectionId();
         
         bool setPingWatchdog(bool enable = true);
+        bool setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs = HAC_KEEPALIVE_DEF_IDLE,
+                             uint32_t intervalMs = HAC_KEEPALIVE_DEF_INTERVAL, 
+                             uint8_t count = HAC_KEEPALIVE_DEF_COUNT);
+        HaCWatchdogMode getWatchdogMode() const;
+        uint32_t lastAckMillis() const;
+        uint32_t lastReceiveMillis() const;
+        void setIdleTimeout(uint32_t timeoutMs);
+        void setManualReceiveWindow(bool enable = true);
+        void consume(uint32_t len);
+        uint32_t unconsumedBytes() const;
+        void setSendWatermarks(uint32_t high, uint32_t low = 0);
+        void setSlowConsumerPolicy(HaCSlowConsumerPolicy policy);
+        uint32_t pendingSendBytes() const;
+        bool isWritable() const;
+        void setReceiveMode(HaCReceiveMode mode);
+        HaCReceiveMode getReceiveMode() const;
+        bool setLineFraming(const char *delimiter = HAC_FRAMER_DEF_DELIMITER, 
+                            uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
+        bool setLengthPrefixFraming(HaCLengthPrefix prefix = HAC_LEN_PREFIX_U16, 
+                                    uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
         #ifdef ESP32  
         bool connect(const ip_addr_t *ip, uint16_t port);        
         #endif
         #ifdef ESP8266
         bool connect(IPAddress ip, uint16_t port);
         #endif
+        bool connect(const char *host, uint16_t port);
+        bool isResolving() const;
+        bool isDraining() const;
         uint8_t socketState() const;
-        long sendData(const char * buffer);
+        long sendData(const char * buffer, HaCMessageToken *token = nullptr);
+        long send(const void *data, size_t len, HaCMessageToken *token = nullptr);
+        long send(const HaCSendSegment *segments, uint8_t count, HaCMessageToken *token = nullptr);
+        long sendNoCopy(const void *data, size_t len, HaCMessageToken *token = nullptr);
+        long sendShared(HaCSharedBuffer *buffer, HaCMessageToken *token = nullptr);
+        void cork();
+        err_t uncork();
+        bool isCorked() const;
+        err_t flush();
+        void setNoDelay(bool enable = true);
         void close(bool forceClose = false);
         void abort();
         void getRemoteIP(char *bufferIP);
+        uint16_t getRemotePort() const;
+        uint16_t getLocalPort() const;
         void setupClientSocket(tcp_pcb* soc);
+        void reset();
+        static bool parseBusyFrame(const char *data, size_t len, uint32_t *retryAfterMs);
+        void setConnectTimeout(uint32_t timeoutMs);
         
+    protected:
+        void _setLinkFn(HaCLinkFn fn, void *ctx);
+        #ifdef HAC_ENABLE_STATIC_MEMORY
+        void _setCallbackStorage(HaCClientCallbacks *storage);
+        #endif
+        bool _hasSocket() const;
 
     private:
         tcp_pcb *_soc = nullptr;
         bool _ignoreCRNLReceiveData = true;
+        HaCReceiveMode _receiveMode = HAC_RX_MODE_TEXT;
+        HaCFramer _framer;
+        HaCSendQueue _txQueue;
         bool _isRemoteEndNotOk = false;
-        bool _enablePingWatchdog = true;
+        HaCWatchdogMode _watchdogMode = HAC_WATCHDOG_PING;
+        uint32_t _keepAliveIdle = HAC_KEEPALIVE_DEF_IDLE;
+        uint32_t _keepAliveInterval = HAC_KEEPALIVE_DEF_INTERVAL;
+        uint8_t _keepAliveCount = HAC_KEEPALIVE_DEF_COUNT;
         uint8_t _connectionNotOkCntr = 0;
-        uint8_t _pollingCounter = 0;  
+        bool _connecting = false;
+        uint32_t _connectStartMs = 0;
+        uint32_t _connectTimeoutMs = HAC_SOCCLIENT_CONNECT_TIMEOUT_MS;
+        HaCLinkFn _linkFn = nullptr;
+        void *_linkCtx = nullptr;
+        bool _resolving = false;
+        uint16_t _resolvePort = 0;
+        ip_addr_t _resolvedIP;
+        uint32_t _probeMs = 0;
+        uint32_t _idleTimeoutMs = 0;
+        bool _manualReceiveWindow = false;
+        uint32_t _unconsumed = 0;
+        uint32_t _withheld = 0;
+        uint32_t _txHighWatermark = HAC_SOCCLIENT_TX_HIGH_WATERMARK;
+        uint32_t _txLowWatermark = HAC_SOCCLIENT_TX_HIGH_WATERMARK / 2;
+        HaCSlowConsumerPolicy _slowConsumerPolicy = HAC_SLOW_CONSUMER_DROP_NEWEST;
+        bool _txAboveHigh = false;
+        bool _slowConsumer = false;//Dropped from the timer, slow consumer or a message cut on the wire
+        bool _noDelay = false;
+        HaCTimer _timer;
+        uint32_t _lastAckMs = 0;
+        uint32_t _lastReceiveMs = 0;
+        tcp_pcb *_lingerSoc = nullptr;//Closed pcb lwIP still sends referenced data from
+        bool _lingerDelete = false;
+        uint16_t _receiving = 0;//Length of the pbuf being delivered to the callbacks
+        bool _receiveClosed = false;
+        bool _receiveAborted = false;
+        bool _receiveDelete = false;
+        std::function<void(HaCClientInfo*, const void*)> _lingerReleasedFn;
         
-        uint8_t _connectionId = 254; // Unasssigned ID
+        HaCConnectionHandle _connectionId = HAC_CONNECTION_HANDLE_INVALID;
         //uint64_t _totalBytesReceive = 0;
-        std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> _onReceiveFn;
-        std::function<void(uint16_t, HaCClientInfo*)> _onSentFn;
-        std::function<void(uint16_t, HaCClientInfo*)> _onErrorFn;
-        std::function<void(HaCClientInfo*)> _onPollFn;
-        std::function<void(HaCClientInfo*)> _onClosedFn;
-        std::function<void(HaCClientInfo*, tcp_pcb*)> _onAcceptedFn;
-        std::function<void(HaCClientInfo*)> _onConnectedFn;
+        const HaCClientCallbacks *_callbacks = nullptr;
+        HaCClientCallbacks *_ownCallbacks = nullptr;
+        #ifdef HAC_ENABLE_STATIC_MEMORY
+        HaCClientCallbacks *_ownCallbacksStorage = nullptr;
+        #endif
 
+        HaCClientCallbacks* _callbackTable();
         void _setup();
+        void _detach();
+        bool _close(bool forceClose, bool abortSocket = false, bool localClose = false);
+        void _linger(tcp_pcb *soc);
+        void _endLinger(bool abortSocket);
+        void _applyWatchdog();
+        void _applyPoll();
+        err_t _admit(uint32_t len);
+        err_t _queued(err_t err, HaCMessageToken *token);
+        err_t _sendPing();
+        void _armTimer();
+        void _onTimer();
+        static void _onTimer(void *ctx);
+        uint32_t _lastActivityMillis() const;
+        static void _onSendDone(void *ctx, const HaCSendEntry &entry);
+        static bool _onFrame(void *ctx, const uint8_t *frame, uint16_t len);
+        void _onResolved(const ip_addr_t *ip);
+        static void _onResolved(void *ctx, const ip_addr_t *ip);
 
         static err_t _onReceive(void *arg, struct tcp_pcb *tpcb,
                                struct pbuf *p, err_t err);
@@ -111,6 +330,11 @@ class HaCClientInfo
                               u16_t len);
         void _onError(err_t err);
         static void _onError(void *arg, err_t err);
+        void _onLingerSent(u16_t len);
+        static err_t _onLingerSent(void *arg, struct tcp_pcb *tpcb, u16_t len);
+        void _onLingerError();
+        static void _onLingerError(void *arg, err_t err);
+        static void _onLingerDone(void *ctx, const HaCSendEntry &entry);
         err_t _onPoll(struct tcp_pcb *tpcb);
         static err_t _onPoll(void *arg, struct tcp_pcb *tpcb);
      
@@ -0,0 +1,97 @@
+/**
+ *
+ * @file HaCClientPool.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef __HAC_CLIENTPOOL_H_
+#define __HAC_CLIENTPOOL_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCClientInfo.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifndef HAC_SERVER_MAX_SOCKET_CLIENTS
+#define HAC_SERVER_MAX_SOCKET_CLIENTS   5
+#endif
+
+#if HAC_SERVER_MAX_SOCKET_CLIENTS > 255
+#error "HAC_SERVER_MAX_SOCKET_CLIENTS must fit in the connection handle slot bits"
+#endif
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Fixed capacity pool of preconstructed connection slots.
+     * Slots are taken and given back through a free list, nothing is allocated 
+     * on connect or disconnect. A pool can be shared by several servers, every slot
+     * records the owner that took it.
+     */
+class HaCClientPool
+{
+    public:
+        static HaCClientPool& shared();
+
+        HaCClientPool();
+        HaCClientPool(const HaCClientPool&) = delete;
+        HaCClientPool& operator=(const HaCClientPool&) = delete;
+
+        HaCClientInfo* acquire(const void *owner = nullptr);
+        void release(HaCClientInfo *clientInfo);
+
+        uint8_t capacity() const;
+        uint8_t used() const;
+        uint8_t used(const void *owner) const;
+        bool isUsed(uint8_t slot) const;
+        bool isUsedBy(uint8_t slot, const void *owner) const;
+        HaCClientInfo* at(uint8_t slot);
+        uint8_t slotOf(const HaCClientInfo *clientInfo) const;
+        HaCConnectionHandle handleOf(const HaCClientInfo *clientInfo) const;
+        HaCClientInfo* find(HaCConnectionHandle handle, const void *owner = nullptr);
+
+    private:
+        HaCClientInfo _slots[HAC_SERVER_MAX_SOCKET_CLIENTS];
+        uint8_t _freeList[HAC_SERVER_MAX_SOCKET_CLIENTS];
+        uint8_t _freeCount = 0;
+        bool _used[HAC_SERVER_MAX_SOCKET_CLIENTS];
+        const void *_owner[HAC_SERVER_MAX_SOCKET_CLIENTS];
+        uint32_t _generation[HAC_SERVER_MAX_SOCKET_CLIENTS];
+};
+/* #endregion */
+
+#include "HaCClientPool-impl.h"
+
+#endif
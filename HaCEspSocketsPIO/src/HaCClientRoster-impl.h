@@ -0,0 +1,159 @@
+/**
+ *
+ * @file HaCClientRoster-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+
+/* #region SELF_HEADER */
+#include "HaCClientRoster.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Constructor
+     * @param pool Connection pool to view
+     * @param exclude Connection left out of the view(e.g. the one being closed)
+     * @param owner Only list the connections of this owner, nullptr for every owner
+     */
+HaCClientRoster::HaCClientRoster(HaCClientPool *pool, const HaCClientInfo *exclude, const void *owner) 
+     : _pool(pool), _exclude(exclude), _owner(owner)
+{
+}
+
+/**
+     * First live connection
+     * @return Iterator
+     */
+HaCClientRoster::Iterator HaCClientRoster::begin() const
+{
+     return Iterator(this, 0);
+}
+
+/**
+     * Past the last slot
+     * @return Iterator
+     */
+HaCClientRoster::Iterator HaCClientRoster::end() const
+{
+     return Iterator(this, this->_pool->capacity());
+}
+
+/**
+     * Number of live connections in the view
+     * @return Connection count
+     */
+uint8_t HaCClientRoster::size() const
+{
+     uint8_t count = this->_pool->used(this->_owner);
+     if(this->_exclude && this->_pool->isUsedBy(this->_pool->slotOf(this->_exclude), this->_owner))
+          count--;
+
+     return count;
+}
+
+/**
+     * Check if the view has no connection
+     * @return True if empty
+     */
+bool HaCClientRoster::empty() const
+{
+     return this->size() == 0;
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Check if a slot is part of the view
+     * @param slot Slot index
+     * @return True if listed
+     */
+bool HaCClientRoster::_listed(uint8_t slot) const
+{
+     return this->_pool->isUsedBy(slot, this->_owner) && this->_pool->at(slot) != this->_exclude;
+}
+
+/* #endregion */
+
+/* #region Iterator */
+
+/**
+     * Constructor
+     * @param roster Roster being iterated
+     * @param slot Starting slot
+     */
+HaCClientRoster::Iterator::Iterator(const HaCClientRoster *roster, uint8_t slot) 
+     : _roster(roster), _slot(slot)
+{
+     this->_skip();
+}
+
+/**
+     * Current connection
+     * @return Connection
+     */
+HaCClientInfo* HaCClientRoster::Iterator::operator*() const
+{
+     return this->_roster->_pool->at(this->_slot);
+}
+
+/**
+     * Move to the next live connection
+     * @return Iterator
+     */
+HaCClientRoster::Iterator& HaCClientRoster::Iterator::operator++()
+{
+     this->_slot++;
+     this->_skip();
+     return *this;
+}
+
+/**
+     * Compare position
+     * @param other Other iterator
+     * @return True if not at the same slot
+     */
+bool HaCClientRoster::Iterator::operator!=(const Iterator &other) const
+{
+     return this->_slot != other._slot;
+}
+
+/**
+     * Skip slots that are not part of the view
+     */
+void HaCClientRoster::Iterator::_skip()
+{
+     uint8_t capacity = this->_roster->_pool->capacity();
+     while(this->_slot < capacity && !this->_roster->_listed(this->_slot))
+          this->_slot++;
+}
+
+/* #endregion */
+
+/* #endregion */
@@ -0,0 +1,122 @@
+/**
+ *
+ * @file HaCDnsCache.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+
+#ifndef __HAC_DNSCACHE_H_
+#define __HAC_DNSCACHE_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCEspSockets.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+#include <lwip/dns.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifndef HAC_DNS_CACHE_SIZE
+#define HAC_DNS_CACHE_SIZE          4       //Host names remembered at once
+#endif
+
+#ifndef HAC_DNS_CACHE_TTL_MS
+#define HAC_DNS_CACHE_TTL_MS        60000   //How long a resolved address is reused before asking lwIP again, not the record TTL
+#endif
+
+#ifndef HAC_DNS_MAX_HOSTNAME_LEN
+#define HAC_DNS_MAX_HOSTNAME_LEN    63      //Longest host name that can be resolved
+#endif
+
+#ifndef HAC_DNS_MAX_WAITERS
+#define HAC_DNS_MAX_WAITERS         4       //Connections that can wait for a lookup at once
+#endif
+
+typedef void (*HaCDnsFoundFn)(void *ctx, const ip_addr_t *ip);
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Library wide host name cache in front of the lwIP resolver.
+     * A resolved address is reused for a fixed time(HAC_DNS_CACHE_TTL_MS or setTtl), lwIP doesn't
+     * report the record TTL to the caller. Keep it below the shortest TTL of the hosts used, after
+     * that lwIP is asked again and answers from its own table for as long as the record TTL allows.
+     * Connections waiting for the same host share one lookup.
+     */
+class HaCDnsCache
+{
+    public:
+        static HaCDnsCache& instance();
+
+        HaCDnsCache(const HaCDnsCache&) = delete;
+        HaCDnsCache& operator=(const HaCDnsCache&) = delete;
+
+        void setTtl(uint32_t ttlMs);
+        err_t resolve(const char *host, ip_addr_t *ip, HaCDnsFoundFn fn, void *ctx);
+        void cancel(void *ctx);
+        void flush();
+
+    private:
+        struct HaCDnsEntry
+        {
+            char host[HAC_DNS_MAX_HOSTNAME_LEN + 1];
+            ip_addr_t ip;
+            uint32_t resolvedMs;
+            bool resolved;
+            bool pending;
+        };
+
+        struct HaCDnsWaiter
+        {
+            HaCDnsEntry *entry;
+            HaCDnsFoundFn fn;
+            void *ctx;
+        };
+
+        HaCDnsEntry _entries[HAC_DNS_CACHE_SIZE] = {};
+        HaCDnsWaiter _waiters[HAC_DNS_MAX_WAITERS] = {};
+        uint32_t _ttlMs = HAC_DNS_CACHE_TTL_MS;
+
+        HaCDnsCache();
+
+        HaCDnsEntry* _entry(const char *host);
+        bool _isFresh(const HaCDnsEntry *entry) const;
+        void _found(HaCDnsEntry *entry, const ip_addr_t *ip);
+        static void _found(const char *name, const ip_addr_t *ip, void *arg);
+};
+/* #endregion */
+
+#include "HaCDnsCache-impl.h"
+
+#endif
@@ -48,6 +48,13 @@
 
 /* #endregion */
 
+/* #region Memory */
+//Build with HAC_ENABLE_STATIC_MEMORY to take the server, client, connection slots and 
+//buffers from fixed storage, nothing is allocated on the heap after setup
+//Opt-in, with it text receive is delivered in chunks of HAC_SOCCLIENT_RX_TEXT_SIZE 
+//and pooled server connections only use the callbacks set on their server
+/* #endregion */
+
 /* #endregion */
 
 /* #region INTERNAL_DEPENDENCY */
@@ -61,7 +68,24 @@
 /* #endregion */
 
 /* #region GLOBAL_DECLARATION */
+#ifdef HAC_ENABLE_STATIC_MEMORY
+//Every slot is embedded in the instance, raise them only for what is used
+#ifndef HAC_SOCKETS_MAX_SERVERS
+#define HAC_SOCKETS_MAX_SERVERS         1
+#endif
 
+#ifndef HAC_SOCKETS_MAX_CLIENTS
+#define HAC_SOCKETS_MAX_CLIENTS         1
+#endif
+#endif
+
+#ifndef HAC_SOCKETS_MAX_SERVERS
+#define HAC_SOCKETS_MAX_SERVERS         3       //Listening ports one instance can run(e.g. data, control and bulk)
+#endif
+
+#ifndef HAC_SOCKETS_MAX_CLIENTS
+#define HAC_SOCKETS_MAX_CLIENTS         3       //Outbound connections one instance can run
+#endif
 /* #endregion */
 
 /* #region CLASS_DECLARATION */
@@ -75,52 +99,125 @@ public:
     ~HaCEspSockets();
 
     void setupServer(uint16_t port);
+    HaCServer* addServer(uint16_t port);
+    HaCServer* getServer(uint16_t port);
+    bool removeServer(uint16_t port);
     void startServer();
     void shutdownServer();
     void ServerBroadCast(const char *message);
+    void ServerBroadCast(const void *data, size_t len);
+    long ServerSend(HaCConnectionHandle handle, const void *data, size_t len, HaCMessageToken *token = nullptr);
+    HaCClientInfo* ServerGetClient(HaCConnectionHandle handle);
+    void ServerSetMaxClients(uint8_t maxClients);
+    void ServerSetBacklog(uint8_t backlog);
+    void ServerSetAdmissionPolicy(HaCAdmissionPolicy policy, uint32_t retryAfterMs = HAC_SERVER_DEF_RETRY_AFTER_MS);
     bool setPingWatchdog(bool enable = true);
+    void setIdleTimeout(uint32_t timeoutMs);
+    void setManualReceiveWindow(bool enable = true);
+    void clientConsume(uint32_t len);
+    void setSendWatermarks(uint32_t high, uint32_t low = 0);
+    void setSlowConsumerPolicy(HaCSlowConsumerPolicy policy);
+    void setNoDelay(bool enable = true);
+    void setHeapThresholds(uint32_t minAccept, uint32_t minReceive, uint32_t minBroadcast);
+    void setDnsCacheTtl(uint32_t ttlMs);
+    bool setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs = HAC_KEEPALIVE_DEF_IDLE,
+                         uint32_t intervalMs = HAC_KEEPALIVE_DEF_INTERVAL, 
+                         uint8_t count = HAC_KEEPALIVE_DEF_COUNT);
+    void setReceiveMode(HaCReceiveMode mode);
+    void setLineFraming(const char *delimiter = HAC_FRAMER_DEF_DELIMITER, 
+                        uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
+    void setLengthPrefixFraming(HaCLengthPrefix prefix = HAC_LEN_PREFIX_U16, 
+                                uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
     /* #region Event functions(Server Events) */
     void Server_clientOnDataArrival(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn);
+    void Server_clientOnDataView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn);
     void Server_clientOnDataSent(std::function<void(uint16_t, HaCClientInfo*)> fn);
     void Server_clientOnSocketError(std::function<void(uint16_t, HaCClientInfo*)> fn);
     void Server_clientOnPoll(std::function<void(HaCClientInfo*)> fn);
+    void Server_clientOnBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn);
+    void Server_clientOnWritable(std::function<void(HaCClientInfo*)> fn);
+    void Server_clientOnMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn);
+    #ifndef HAC_ENABLE_STATIC_MEMORY
     void Server_clientOnSocketClosed(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn); 
     void Server_onNewClientConnection(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn);       
+    #endif
+    void Server_onClientJoined(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn);
+    void Server_onClientLeft(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn);
     /* #endregion */
 
     void setupClient(uint16_t remotePort, const char * remoteIP);
-    long clientSend(const char *message);
+    HaCClient* addClient(uint16_t remotePort, const char * remoteIP);
+    HaCClient* getOutboundClient(uint8_t index);
+    bool removeClient(HaCClient *client);
+    long clientSend(const char *message, HaCMessageToken *token = nullptr);
+    long clientSend(const void *data, size_t len, HaCMessageToken *token = nullptr);
+    long clientSend(const HaCSendSegment *segments, uint8_t count, HaCMessageToken *token = nullptr);
+    long clientSendNoCopy(const void *data, size_t len, HaCMessageToken *token = nullptr);
+    void clientCork();
+    long clientUncork();
+    long clientFlush();
     bool clientConnect();
+    void clientSetAutoReconnect(bool enable = true, uint32_t minDelayMs = HAC_RECONNECT_MIN_DELAY_MS, 
+                                uint32_t maxDelayMs = HAC_RECONNECT_MAX_DELAY_MS);
+    void clientSetConnectTimeout(uint32_t timeoutMs);
+    HaCClientState clientState();
     void clientClose();    
 
     /* #region Event functions(Client Events) */
     void clientOnDataArrival(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn);
+    void clientOnDataView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn);
     void clientOnDataSent(std::function<void(uint16_t, HaCClientInfo*)> fn);
     void clientOnSocketError(std::function<void(uint16_t, HaCClientInfo*)> fn);
     void clientOnPoll(std::function<void(HaCClientInfo*)> fn);
     void clientOnSocketClosed(std::function<void(HaCClientInfo*)> fn);     
     void clientOnConnected(std::function<void(HaCClientInfo*)> fn);
+    void clientOnBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn);
+    void clientOnWritable(std::function<void(HaCClientInfo*)> fn);
+    void clientOnMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn);
     /* #endregion */
 
 
 private: 
-    uint16_t _serverListenPort;
-    HaCServer *_socketServer = nullptr;
-    HaCClient *_socketClient = nullptr;
+    HaCReceiveMode _receiveMode = HAC_RX_MODE_TEXT;
+    const char *_frameDelimiter = HAC_FRAMER_DEF_DELIMITER;
+    uint16_t _maxFrameLength = HAC_FRAMER_DEF_MAX_LENGTH;
+    HaCLengthPrefix _lengthPrefix = HAC_LEN_PREFIX_U16;
+
+    void _applyReceiveMode();
+    void _applyReceiveMode(HaCClientInfo *client);
+    void _applyReceiveMode(HaCServer *server);
+    HaCServer* _createServer(uint8_t index);
+    HaCClient* _createClient(uint8_t index);
+
+    //First server and client are the ones of the single instance functions(e.g. startServer and clientSend)
+    HaCServer *_servers[HAC_SOCKETS_MAX_SERVERS] = {};
+    HaCClient *_clients[HAC_SOCKETS_MAX_CLIENTS] = {};
+    #ifdef HAC_ENABLE_STATIC_MEMORY
+    HaCServer _serverStorage[HAC_SOCKETS_MAX_SERVERS];
+    HaCClient _clientStorage[HAC_SOCKETS_MAX_CLIENTS];
+    #endif
     
     std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> _server_clientOnDataArrivalFn;
+    std::function<void(HaCClientInfo*, const HaCPbufView&)> _server_clientOnDataViewFn;
     std::function<void(uint16_t, HaCClientInfo*)> _server_clientOnDataSentFn;
     std::function<void(uint16_t, HaCClientInfo*)> _server_clientOnSocketErrorFn;
     std::function<void(HaCClientInfo*)> _server_clientOnPollFn;
+    std::function<void(HaCClientInfo*, const void*)> _server_clientOnBufferReleasedFn;
+    std::function<void(HaCClientInfo*)> _server_clientOnWritableFn;
+    std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> _server_clientOnMessageSentFn;
+    #ifndef HAC_ENABLE_STATIC_MEMORY
     std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> _server_clientOnSocketClosedFn;
     std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> _server_onNewClientConnectionFn;
+    #endif
+    std::function<void(HaCClientInfo*, const HaCClientRoster&)> _server_onClientJoinedFn;
+    std::function<void(HaCClientInfo*, const HaCClientRoster&)> _server_onClientLeftFn;
 
-    std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> _clientOnDataArrivalFn;
-    std::function<void(uint16_t, HaCClientInfo*)> _clientOnDataSentFn;
-    std::function<void(uint16_t, HaCClientInfo*)> _clientOnSocketErrorFn;
-    std::function<void(HaCClientInfo*)> _clientOnPollFn;
+    HaCClientCallbacks _clientCallbacks; //Shared by every outbound client
     std::function<void(HaCClientInfo*)> _clientOnSocketClosedFn;
-    std::function<void(HaCClientInfo*)> _clientOnConnectedFn;
+    bool _clientAutoReconnect = false;
+    uint32_t _clientReconnectMinMs = HAC_RECONNECT_MIN_DELAY_MS;
+    uint32_t _clientReconnectMaxMs = HAC_RECONNECT_MAX_DELAY_MS;
+    uint32_t _clientConnectTimeoutMs = 0;
 };
 
 
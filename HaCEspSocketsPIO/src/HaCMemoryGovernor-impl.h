@@ -0,0 +1,119 @@
+/**
+ *
+ * @file HaCMemoryGovernor-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+
+/* #region SELF_HEADER */
+#include "HaCMemoryGovernor.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Library wide governor
+     * @return Memory governor
+     */
+HaCMemoryGovernor& HaCMemoryGovernor::instance()
+{
+     static HaCMemoryGovernor governor;
+     return governor;
+}
+
+/**
+     * Set the free heap thresholds, 0 disables a threshold
+     * @param minAccept Free heap below which new connections are refused
+     * @param minReceive Free heap below which receive windows stay closed
+     * @param minBroadcast Free heap below which broadcasts are dropped
+     */
+void HaCMemoryGovernor::setThresholds(uint32_t minAccept, uint32_t minReceive, uint32_t minBroadcast)
+{
+     this->_minAccept = minAccept;
+     this->_minReceive = minReceive;
+     this->_minBroadcast = minBroadcast;
+}
+
+/**
+     * Free heap
+     * @return Free heap in bytes
+     */
+uint32_t HaCMemoryGovernor::freeHeap() const
+{
+     return ESP.getFreeHeap();
+}
+
+/**
+     * Check if there is enough heap for a new connection
+     * @return True if a connection can be accepted
+     */
+bool HaCMemoryGovernor::canAccept() const
+{
+     return this->_isAbove(this->_minAccept);
+}
+
+/**
+     * Check if there is enough heap to let the peers send more data
+     * @return True if receive windows can be reopened
+     */
+bool HaCMemoryGovernor::canReceive() const
+{
+     return this->_isAbove(this->_minReceive);
+}
+
+/**
+     * Check if there is enough heap to queue a broadcast
+     * @return True if a broadcast can be sent
+     */
+bool HaCMemoryGovernor::canBroadcast() const
+{
+     return this->_isAbove(this->_minBroadcast);
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Constructor
+     */
+HaCMemoryGovernor::HaCMemoryGovernor()
+{
+}
+
+/**
+     * Check the free heap against a threshold, the heap is only read if the threshold is set
+     * @param threshold Minimum free heap, 0 if disabled
+     * @return True if the threshold is disabled or the free heap is at or above it
+     */
+bool HaCMemoryGovernor::_isAbove(uint32_t threshold) const
+{
+     return !threshold || this->freeHeap() >= threshold;
+}
+
+/* #endregion */
+
+/* #endregion */
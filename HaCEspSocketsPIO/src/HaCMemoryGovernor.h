@@ -0,0 +1,99 @@
+/**
+ *
+ * @file HaCMemoryGovernor.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#ifndef __HAC_MEMORYGOVERNOR_H_
+#define __HAC_MEMORYGOVERNOR_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCEspSockets.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifndef HAC_HEAP_MIN_ACCEPT
+#define HAC_HEAP_MIN_ACCEPT     0       //Free heap below which new connections are refused, 0 to disable
+#endif
+
+#ifndef HAC_HEAP_MIN_RECEIVE
+#define HAC_HEAP_MIN_RECEIVE    0       //Free heap below which receive windows stay closed, 0 to disable
+#endif
+
+#ifndef HAC_HEAP_MIN_BROADCAST
+#define HAC_HEAP_MIN_BROADCAST  0       //Free heap below which broadcasts are dropped, 0 to disable
+#endif
+
+#ifndef HAC_HEAP_RECHECK_MS
+#define HAC_HEAP_RECHECK_MS     500     //How often a paused receive window checks the free heap again
+#endif
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Library wide free heap thresholds.
+     * Below its threshold each kind of work that needs memory is held back, new connections
+     * first, then broadcasts and receive windows, so the device degrades instead of running
+     * out of heap. Receive windows reopen by themselves once the heap recovers.
+     */
+class HaCMemoryGovernor
+{
+    public:
+        static HaCMemoryGovernor& instance();
+
+        HaCMemoryGovernor(const HaCMemoryGovernor&) = delete;
+        HaCMemoryGovernor& operator=(const HaCMemoryGovernor&) = delete;
+
+        void setThresholds(uint32_t minAccept, uint32_t minReceive, uint32_t minBroadcast);
+        uint32_t freeHeap() const;
+        bool canAccept() const;
+        bool canReceive() const;
+        bool canBroadcast() const;
+
+    private:
+        uint32_t _minAccept = HAC_HEAP_MIN_ACCEPT;
+        uint32_t _minReceive = HAC_HEAP_MIN_RECEIVE;
+        uint32_t _minBroadcast = HAC_HEAP_MIN_BROADCAST;
+
+        HaCMemoryGovernor();
+
+        bool _isAbove(uint32_t threshold) const;
+};
+/* #endregion */
+
+#include "HaCMemoryGovernor-impl.h"
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ *
+ * @file HaCPbufView-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/* #region SELF_HEADER */
+#include "HaCPbufView.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Constructor
+     * @param p Head of the received pbuf chain
+     */
+HaCPbufView::HaCPbufView(const pbuf *p) 
+{
+     this->_head = p;
+}
+
+/**
+     * Total length of the chain
+     * @return Number of bytes on all the segments
+     */
+uint16_t HaCPbufView::totalLength() const
+{
+     return this->_head ? this->_head->tot_len : 0;
+}
+
+/**
+     * Number of pbuf segments on the chain
+     * @return Segment count
+     */
+uint8_t HaCPbufView::segmentCount() const
+{
+     uint8_t count = 0;
+     for(const pbuf *p = this->_head; p; p = p->next)
+          count++;
+
+     return count;
+}
+
+/**
+     * Get a single byte from the chain
+     * @param index Byte offset from the start of the chain
+     * @return Byte value or -1 if the index is out of range
+     */
+int16_t HaCPbufView::byteAt(uint16_t index) const
+{
+     for(const pbuf *p = this->_head; p; p = p->next)
+     {
+          if(index < p->len)
+               return ((const uint8_t*)p->payload)[index];
+          index -= p->len;
+     }
+
+     return -1;
+}
+
+/**
+     * Copy part of the chain to a contiguous buffer
+     * @param dst Destination buffer
+     * @param len Maximum number of bytes to copy
+     * @param offset Byte offset from the start of the chain
+     * @return Number of bytes copied
+     */
+uint16_t HaCPbufView::copyTo(void *dst, uint16_t len, uint16_t offset) const
+{
+     uint8_t *d = (uint8_t*)dst;
+     uint16_t copied = 0;
+
+     for(const pbuf *p = this->_head; p && copied < len; p = p->next)
+     {
+          if(offset >= p->len)
+          {
+               offset -= p->len;
+               continue;
+          }
+
+          uint16_t n = p->len - offset;
+          if(n > len - copied)
+               n = len - copied;
+
+          memcpy(d + copied, (const uint8_t*)p->payload + offset, n);
+          copied += n;
+          offset = 0;
+     }
+
+     return copied;
+}
+
+/* #endregion */
+
+/* #endregion */
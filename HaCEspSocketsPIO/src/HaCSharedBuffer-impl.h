@@ -0,0 +1,171 @@
+/**
+ *
+ * @file HaCSharedBuffer-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/* #region SELF_HEADER */
+#include "HaCSharedBuffer.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Create a shared buffer holding a copy of the data, the caller owns the first reference
+     * @param data Payload
+     * @param len Payload length
+     * @return Shared buffer or nullptr if out of memory
+     */
+HaCSharedBuffer* HaCSharedBuffer::create(const void *data, uint16_t len)
+{
+     #ifdef HAC_ENABLE_STATIC_MEMORY
+     if(len > HAC_SHARED_BUFFER_BLOCK_SIZE)
+          return nullptr;
+
+     uint8_t index = 0;
+     bool *used = HaCSharedBuffer::_blockUsed();
+     while(index < HAC_SHARED_BUFFER_POOL_SIZE && used[index])
+          index++;
+
+     if(index >= HAC_SHARED_BUFFER_POOL_SIZE)
+          return nullptr;
+
+     used[index] = true;
+     uint8_t *block = HaCSharedBuffer::_blockAt(index);
+     HaCSharedBuffer *buffer = new (block) HaCSharedBuffer(len);
+     buffer->_block = index;
+     #else
+     uint8_t *block = new uint8_t[sizeof(HaCSharedBuffer) + len];
+     if(!block)
+          return nullptr;
+
+     HaCSharedBuffer *buffer = new (block) HaCSharedBuffer(len);
+     #endif
+     memcpy(block + sizeof(HaCSharedBuffer), data, len);
+
+     return buffer;
+}
+
+/**
+     * Add a reference
+     */
+void HaCSharedBuffer::retain()
+{
+     this->_references++;
+}
+
+/**
+     * Release a reference, the buffer is freed with the last one
+     */
+void HaCSharedBuffer::release()
+{
+     if(--this->_references)
+          return;
+
+     #ifdef HAC_ENABLE_STATIC_MEMORY
+     uint8_t index = this->_block;
+     this->~HaCSharedBuffer();
+     HaCSharedBuffer::_blockUsed()[index] = false;
+     #else
+     this->~HaCSharedBuffer();
+     delete[] reinterpret_cast<uint8_t*>(this);
+     #endif
+}
+
+/**
+     * Payload
+     * @return Payload pointer
+     */
+const uint8_t* HaCSharedBuffer::data() const
+{
+     return reinterpret_cast<const uint8_t*>(this) + sizeof(HaCSharedBuffer);
+}
+
+/**
+     * Payload length
+     * @return Payload length
+     */
+uint16_t HaCSharedBuffer::length() const
+{
+     return this->_len;
+}
+
+/**
+     * Number of references
+     * @return Reference count
+     */
+uint16_t HaCSharedBuffer::references() const
+{
+     return this->_references;
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Constructor
+     * @param len Payload length
+     */
+HaCSharedBuffer::HaCSharedBuffer(uint16_t len) 
+{
+     this->_len = len;
+}
+
+/**
+     * Destructor
+     */
+HaCSharedBuffer::~HaCSharedBuffer()
+{
+}
+
+#ifdef HAC_ENABLE_STATIC_MEMORY
+/**
+     * Block of the static pool
+     * @param index Block index
+     * @return Block start, large enough for the header and HAC_SHARED_BUFFER_BLOCK_SIZE bytes
+     */
+uint8_t* HaCSharedBuffer::_blockAt(uint8_t index)
+{
+     static const size_t blockSize = (sizeof(HaCSharedBuffer) + HAC_SHARED_BUFFER_BLOCK_SIZE + 3) & ~(size_t)3;
+     alignas(HaCSharedBuffer) static uint8_t blocks[HAC_SHARED_BUFFER_POOL_SIZE * blockSize];
+     return &blocks[index * blockSize];
+}
+
+/**
+     * In use flags of the static pool
+     * @return Flag per block
+     */
+bool* HaCSharedBuffer::_blockUsed()
+{
+     static bool used[HAC_SHARED_BUFFER_POOL_SIZE] = { false };
+     return used;
+}
+#endif
+
+/* #endregion */
+
+/* #endregion */
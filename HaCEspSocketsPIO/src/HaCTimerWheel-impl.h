@@ -0,0 +1,259 @@
+/**
+ *
+ * @file HaCTimerWheel-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+
+/* #region SELF_HEADER */
+#include "HaCTimerWheel.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Library wide wheel
+     * @return Timer wheel
+     */
+HaCTimerWheel& HaCTimerWheel::instance()
+{
+     static HaCTimerWheel wheel;
+     return wheel;
+}
+
+/**
+     * Start or restart a timer
+     * @param timer Timer, must stay valid until it expires or is stopped
+     * @param delayMs Delay, rounded up to the next HAC_TIMER_TICK_MS
+     * @param fn Called once on expiry, it may start the timer again
+     * @param ctx Passed to fn
+     */
+void HaCTimerWheel::start(HaCTimer *timer, uint32_t delayMs, HaCTimerFn fn, void *ctx)
+{
+     this->stop(timer);
+
+     //Idle wheel, restart counting from now
+     if(!this->_count)
+          this->_tickMs = millis();
+
+     uint32_t ticks = (delayMs + HAC_TIMER_TICK_MS - 1) / HAC_TIMER_TICK_MS;
+     timer->expires = this->_tick + (ticks ? ticks : 1);
+     timer->fn = fn;
+     timer->ctx = ctx;
+
+     this->_link(timer);
+     this->_count++;
+     this->_arm();
+}
+
+/**
+     * Stop a timer, nothing happens if it is not running
+     * @param timer Timer
+     */
+void HaCTimerWheel::stop(HaCTimer *timer)
+{
+     if(!timer->pprev)
+          return;
+
+     this->_unlink(timer);
+     this->_count--;
+}
+
+/**
+     * Check if a timer is running
+     * @param timer Timer
+     * @return True if running
+     */
+bool HaCTimerWheel::isActive(const HaCTimer *timer) const
+{
+     return timer->pprev != nullptr;
+}
+
+/**
+     * Number of running timers
+     * @return Timer count
+     */
+uint16_t HaCTimerWheel::count() const
+{
+     return this->_count;
+}
+
+/**
+     * Process the ticks elapsed since the last call and fire the expired timers.
+     * The lwIP timeout is scheduled again if it got lost.
+     */
+void HaCTimerWheel::advance()
+{
+     uint32_t now = millis();
+     while(this->_count && now - this->_tickMs >= HAC_TIMER_TICK_MS)
+     {
+          this->_tickMs += HAC_TIMER_TICK_MS;
+          this->_tick++;
+
+          if(!(this->_tick & HAC_TIMER_WHEEL_MASK))
+               this->_cascade();
+
+          this->_expire();
+     }
+
+     this->_arm();
+}
+
+/**
+     * Schedule the lwIP timeout again if it got lost, no timer fires from here
+     */
+void HaCTimerWheel::check()
+{
+     this->_arm();
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Constructor
+     */
+HaCTimerWheel::HaCTimerWheel() 
+{
+     for(uint8_t i = 0; i < HAC_TIMER_WHEEL_SLOTS; i++)
+     {
+          this->_near[i] = nullptr;
+          this->_far[i] = nullptr;
+     }
+}
+
+/**
+     * Put a timer in the slot of its expiry tick
+     * @param timer Timer
+     */
+void HaCTimerWheel::_link(HaCTimer *timer)
+{
+     uint32_t delta = timer->expires - this->_tick;
+     HaCTimer **slot;
+
+     if(delta < HAC_TIMER_WHEEL_SLOTS)
+          slot = &this->_near[timer->expires & HAC_TIMER_WHEEL_MASK];
+     else if(delta < (uint32_t)HAC_TIMER_WHEEL_SLOTS * (HAC_TIMER_WHEEL_SLOTS - 1))
+          slot = &this->_far[(timer->expires >> HAC_TIMER_WHEEL_BITS) & HAC_TIMER_WHEEL_MASK];
+     else //Beyond the wheel, parked on the last far slot and placed again when it cascades
+          slot = &this->_far[((this->_tick >> HAC_TIMER_WHEEL_BITS) - 1) & HAC_TIMER_WHEEL_MASK];
+
+     timer->next = *slot;
+     if(timer->next)
+          timer->next->pprev = &timer->next;
+     timer->pprev = slot;
+     *slot = timer;
+}
+
+/**
+     * Take a timer out of its slot
+     * @param timer Timer
+     */
+void HaCTimerWheel::_unlink(HaCTimer *timer)
+{
+     *timer->pprev = timer->next;
+     if(timer->next)
+          timer->next->pprev = timer->pprev;
+
+     timer->next = nullptr;
+     timer->pprev = nullptr;
+}
+
+/**
+     * Move the timers of the current far slot down to the near slots
+     */
+void HaCTimerWheel::_cascade()
+{
+     HaCTimer **slot = &this->_far[(this->_tick >> HAC_TIMER_WHEEL_BITS) & HAC_TIMER_WHEEL_MASK];
+     HaCTimer *timer = *slot;
+     *slot = nullptr;
+
+     while(timer)
+     {
+          HaCTimer *next = timer->next;
+          timer->next = nullptr;
+          timer->pprev = nullptr;
+          this->_link(timer);
+          timer = next;
+     }
+}
+
+/**
+     * Fire the timers of the current tick, one at a time so a callback 
+     * may start or stop any timer
+     */
+void HaCTimerWheel::_expire()
+{
+     HaCTimer **slot = &this->_near[this->_tick & HAC_TIMER_WHEEL_MASK];
+     while(*slot)
+     {
+          HaCTimer *timer = *slot;
+          this->_unlink(timer);
+          this->_count--;
+
+          if(timer->fn)
+               timer->fn(timer->ctx);
+     }
+}
+
+/**
+     * Schedule the next tick with lwIP while timers are running.
+     * sys_timeout can't report a failure, a tick that is a whole period late 
+     * is taken as never scheduled and scheduled again.
+     */
+void HaCTimerWheel::_arm()
+{
+     if(!this->_count)
+          return;
+
+     uint32_t now = millis();
+     if(this->_armed)
+     {
+          if(now - this->_armedMs < 2 * HAC_TIMER_TICK_MS)
+               return;
+          sys_untimeout(&HaCTimerWheel::_onTick, this);
+     }
+
+     this->_armed = true;
+     this->_armedMs = now;
+     sys_timeout(HAC_TIMER_TICK_MS, &HaCTimerWheel::_onTick, this);
+}
+
+/**
+     * lwIP timeout callback
+     * @param arg HaCTimerWheel pointer
+     */
+void HaCTimerWheel::_onTick(void *arg)
+{
+     HaCTimerWheel *self = reinterpret_cast<HaCTimerWheel*>(arg);
+     self->_armed = false;
+     self->advance();
+}
+
+/* #endregion */
+
+/* #endregion */
@@ -123,7 +123,7 @@ void Server_clientOnDataArrival_CB(HaCClientInfo * clientInfo,
     const char* buffer, uint16_t packLen, uint32_t totalLen)
 {
 
-    DBG_CB_HSOC2("\n[Main] Incoming data from client connection id = %d", clientInfo->getConnectionId()); 
+    DBG_CB_HSOC2("\n[Main] Incoming data from client connection id = %lu", (unsigned long)clientInfo->getConnectionId()); 
     DBG_CB_HSOC2("\n[Main] Data receive = %s", buffer);
     DBG_CB_HSOC2("\n[Main] Packet length = %d ", packLen);
     DBG_CB_HSOC2("\n[Main] Total Data length = %lu ", (unsigned long)totalLen);
@@ -143,11 +143,11 @@ void Server_clientOnDataArrival_CB(HaCClientInfo * clientInfo,
      */
 void Server_onNewClientConnection_CB(HaCClientInfo * clientInfo, std::vector<HaCClientInfo*> clientInfos)
 {
-  DBG_CB_HSOC2("\n[Main] New Client with connection id = %d has been accepted..\n", clientInfo->getConnectionId());
+  DBG_CB_HSOC2("\n[Main] New Client with connection id = %lu has been accepted..\n", (unsigned long)clientInfo->getConnectionId());
 
   DBG_CB_HSOC("[Main] Active Connections \n");
   for(auto p : clientInfos)
-    DBG_CB_HSOC2("\n[Main] Client with connection id = %d", p->getConnectionId());
+    DBG_CB_HSOC2("\n[Main] Client with connection id = %lu", (unsigned long)p->getConnectionId());
 }
 
 /**
@@ -157,7 +157,7 @@ void Server_onNewClientConnection_CB(HaCClientInfo * clientInfo, std::vector<HaC
      */
 void Server_clientOnDataSent_CB(uint16_t len, HaCClientInfo * clientInfo)
 {
-  DBG_CB_HSOC2("\n[Main] Sent to the client = %d with total length = %lu ..", clientInfo->getConnectionId(), (unsigned long)len);  
+  DBG_CB_HSOC2("\n[Main] Sent to the client = %lu with total length = %lu ..", (unsigned long)clientInfo->getConnectionId(), (unsigned long)len);  
 }
 
 /**
@@ -167,11 +167,11 @@ void Server_clientOnDataSent_CB(uint16_t len, HaCClientInfo * clientInfo)
      */
 void Server_clientOnSocketClosed_CB(HaCClientInfo * clientInfo, std::vector<HaCClientInfo*> clientInfos)
 {
-  DBG_CB_HSOC2("\n[Main] Client with connection id = %d has been closed \n", clientInfo->getConnectionId());
+  DBG_CB_HSOC2("\n[Main] Client with connection id = %lu has been closed \n", (unsigned long)clientInfo->getConnectionId());
 
   DBG_CB_HSOC("[Main] Active Connections:");
   for(auto p : clientInfos)
-    DBG_CB_HSOC2("\n[Main] Client with connection id = %d", p->getConnectionId());
+    DBG_CB_HSOC2("\n[Main] Client with connection id = %lu", (unsigned long)p->getConnectionId());
   
 }
 
@@ -182,7 +182,7 @@ void Server_clientOnSocketClosed_CB(HaCClientInfo * clientInfo, std::vector<HaCC
      */
 void Server_clientOnError_CB(uint32_t err, HaCClientInfo * clientInfo)
 {
-  DBG_CB_HSOC2("\n[Main] Client = %d, has error = %lu ..", clientInfo->getConnectionId(), (unsigned long)err);
+  DBG_CB_HSOC2("\n[Main] Client = %lu, has error = %lu ..", (unsigned long)clientInfo->getConnectionId(), (unsigned long)err);
 }
 
 /**
@@ -191,7 +191,7 @@ void Server_clientOnError_CB(uint32_t err, HaCClientInfo * clientInfo)
      */
 void Server_clientOnPoll_CB(HaCClientInfo * clientInfo)
 {
-  //DBG_CB_HSOC2("\n Client with connection id = %d is polling..", clientInfo->getConnectionId());
+  //DBG_CB_HSOC2("\n Client with connection id = %lu is polling..", (unsigned long)clientInfo->getConnectionId());
 }
 
 /* #endregion */ 
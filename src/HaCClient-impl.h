@@ -36,37 +36,49 @@
      */
 HaCClient::HaCClient()
 {
-
+    HaCClientInfo::_setLinkFn(&HaCClient::_onLink, this);
+    #ifdef HAC_ENABLE_STATIC_MEMORY
+    HaCClientInfo::_setCallbackStorage(&this->_callbackStorage);
+    #endif
 }
 
 /**
      * Setup client.
      * @param remotePort server remote port
-     * @param remoteIP server remote IP
+     * @param remoteHost server remote IP or host name, a host name is resolved on connect
      */
-void HaCClient::setup(uint16_t remotePort, const char * remoteIP)
+void HaCClient::setup(uint16_t remotePort, const char * remoteHost)
 {
     
-    tcp_pcb *soc = tcp_new();         
-    if(!soc)
-        return;
-    
     if(remotePort <= 0) 
     {   
         DBG_CB_HSOC("[HACCLIENT] Invalid port!");
         return;
     }
     
-    ip_addr_t ip;
-    if(!this->_parseIP(remoteIP, &ip))
+    ip_addr_t ip = {};
+    bool isIP = this->_parseIP(remoteHost, &ip);
+    if(!isIP && (!remoteHost || !*remoteHost || strlen(remoteHost) > HAC_DNS_MAX_HOSTNAME_LEN))
     {
-        DBG_CB_HSOC("[HACCLIENT] Invalid IP!");
+        DBG_CB_HSOC("[HACCLIENT] Invalid IP or host name!");
         return;
     }
     
+    //A pcb of a previous setup is not connected yet, it would leak otherwise
+    this->abort();
+
+    //Created once the remote is valid, it would leak otherwise
+    tcp_pcb *soc = tcp_new();         
+    if(!soc)
+        return;
+    
     this->_remotePort = remotePort;
-    this->_remoteIP = &ip;
-    soc->remote_ip = *this->_remoteIP;
+    this->_remoteIP = ip;
+    if(isIP)
+        this->_remoteHost[0] = '\0';
+    else
+        strcpy(this->_remoteHost, remoteHost);
+    soc->remote_ip = this->_remoteIP;
     soc->remote_port = this->_remotePort;
     
     HaCClientInfo::setupClientSocket(soc);
@@ -79,12 +91,180 @@ void HaCClient::setup(uint16_t remotePort, const char * remoteIP)
 HaCClient::~HaCClient() 
 {
      DBG_CB_HSOC("[HACCLIENT] Destroying HaCClient..");          
+     HaCTimerWheel::instance().stop(&this->_retryTimer);
+}
+
+/**
+     * Connect to the remote given to setup, a new pcb is created if the previous connection is gone
+     * @return True if the connection is started, or retried later with auto reconnect
+     */
+bool HaCClient::connect()
+{
+    if(this->_state == HAC_CLIENT_CONNECTING || this->_state == HAC_CLIENT_CONNECTED)
+        return true;
+
+    HaCTimerWheel::instance().stop(&this->_retryTimer);
+    this->_retries = 0;
+    this->_state = HAC_CLIENT_CONNECTING;
+    if(this->_attempt())
+        return true;
+
+    this->_retry(ERR_CONN);
+    return this->_state == HAC_CLIENT_BACKOFF;
+}
+
+/**
+     * Retry a lost or failed connection by itself. The delay starts at minDelayMs, doubles
+     * on every failed attempt up to maxDelayMs and up to HAC_RECONNECT_JITTER_PCT of it is
+     * taken off at random. It starts over once connected.
+     * @param enable True to reconnect, close and abort always stop it
+     * @param minDelayMs Delay before the first retry
+     * @param maxDelayMs Longest delay between retries
+     */
+void HaCClient::setAutoReconnect(bool enable, uint32_t minDelayMs, uint32_t maxDelayMs)
+{
+    this->_autoReconnect = enable;
+    this->_reconnectMinMs = minDelayMs ? minDelayMs : 1;
+    this->_reconnectMaxMs = maxDelayMs < this->_reconnectMinMs ? this->_reconnectMinMs : maxDelayMs;
+
+    if(!enable && this->_state == HAC_CLIENT_BACKOFF)
+    {
+        HaCTimerWheel::instance().stop(&this->_retryTimer);
+        this->_state = HAC_CLIENT_IDLE;
+    }
+}
+
+/**
+     * Connection state
+     * @return HAC_CLIENT_IDLE, HAC_CLIENT_CONNECTING, HAC_CLIENT_CONNECTED or HAC_CLIENT_BACKOFF
+     */
+HaCClientState HaCClient::getState() const
+{
+    return this->_state;
+}
+
+/**
+     * Failed attempts since the last connection
+     * @return Number of retries
+     */
+uint16_t HaCClient::retryCount() const
+{
+    return this->_retries;
 }
 
 /* #endregion */
 
 /* #region Private */
 
+/**
+     * Start one connect attempt
+     * @return True if the lookup or the connection is started
+     */
+bool HaCClient::_attempt()
+{
+    //lwIP frees the pcb once a connection is gone, every attempt after that needs a new one
+    if(!HaCClientInfo::_hasSocket())
+    {
+        tcp_pcb *soc = tcp_new();
+        if(!soc)
+            return false;
+
+        HaCClientInfo::setupClientSocket(soc);
+    }
+
+    if(this->_remoteHost[0])
+        return HaCClientInfo::connect(this->_remoteHost, this->_remotePort);
+
+    return HaCClientInfo::connect(&this->_remoteIP, this->_remotePort);
+}
+
+/**
+     * Connection or attempt ended, wait and try again if auto reconnect is on
+     * @param err Reason
+     */
+void HaCClient::_retry(err_t err)
+{
+    if(!this->_autoReconnect)
+    {
+        this->_state = HAC_CLIENT_IDLE;
+        return;
+    }
+
+    uint32_t delayMs = this->_retryDelay();
+    this->_state = HAC_CLIENT_BACKOFF;
+    HaCTimerWheel::instance().start(&this->_retryTimer, delayMs, &HaCClient::_onRetryTimer, this);
+    DBG_CB_HSOC2("\n[HACCLIENT] Connection down(%d), retry %u in %lu ms\n", err, this->_retries, (unsigned long)delayMs);
+}
+
+/**
+     * Next retry delay, capped exponential backoff with jitter
+     * @return Delay in ms
+     */
+uint32_t HaCClient::_retryDelay()
+{
+    uint32_t delayMs = this->_reconnectMinMs;
+    for(uint16_t i = 0; i < this->_retries && delayMs < this->_reconnectMaxMs; i++)
+        delayMs = delayMs > this->_reconnectMaxMs / 2 ? this->_reconnectMaxMs : delayMs * 2;
+    if(delayMs > this->_reconnectMaxMs)
+        delayMs = this->_reconnectMaxMs;
+
+    if(this->_retries < 0xFFFF)
+        this->_retries++;
+
+    //Spread over [delay - jitter, delay] so a fleet dropped by the same outage doesn't retry in step
+    uint32_t jitterMs = (uint32_t)((uint64_t)delayMs * HAC_RECONNECT_JITTER_PCT / 100);
+    if(jitterMs)
+        delayMs -= random(jitterMs + 1);
+
+    return delayMs;
+}
+
+/**
+     * Connection up or down
+     * @param err ERR_OK once connected, the reason otherwise
+     */
+void HaCClient::_onLink(err_t err)
+{
+    if(err == ERR_OK)
+    {
+        this->_state = HAC_CLIENT_CONNECTED;
+        this->_retries = 0;
+        return;
+    }
+
+    //Closed or aborted by the application, through this object or its HaCClientInfo
+    if(err == HAC_ERR_LOCAL_CLOSE || this->_state == HAC_CLIENT_IDLE)
+    {
+        this->_state = HAC_CLIENT_IDLE;
+        HaCTimerWheel::instance().stop(&this->_retryTimer);
+        return;
+    }
+
+    this->_retry(err);
+}
+
+/**
+     * Link Calback function of HaCClientInfo
+     * @param ctx HaCClient pointer
+     * @param err ERR_OK once connected, the reason otherwise
+     */
+void HaCClient::_onLink(void *ctx, err_t err)
+{
+    reinterpret_cast<HaCClient*>(ctx)->_onLink(err);
+}
+
+/**
+     * Backoff timer Calback function, start the next attempt
+     * @param ctx HaCClient pointer
+     */
+void HaCClient::_onRetryTimer(void *ctx)
+{
+    HaCClient *self = reinterpret_cast<HaCClient*>(ctx);
+    self->_state = HAC_CLIENT_CONNECTING;
+    if(!self->_attempt())
+        self->_retry(ERR_CONN);
+}
+
 /**
      * Parse string IP and convert it to ip_addr_t
      * @param ipStr IP String
@@ -92,6 +272,8 @@ HaCClient::~HaCClient()
      */
 bool HaCClient::_parseIP(const char *ipStr, ip_addr_t *ip) 
 {    
+    if(!ipStr) return false;
+
     uint16_t octet[4] = {0, 0, 0, 0};
     uint8_t i = 0;
     uint8_t validOctetCntr = 0;
@@ -114,7 +296,8 @@ bool HaCClient::_parseIP(const char *ipStr, ip_addr_t *ip)
             digitNo++;
             ipStr++;
         }
-        if(digitNo < 3) validOctetCntr++;
+        if(i >= 4) return false;
+        if(digitNo > 0 && digitNo <= 3) validOctetCntr++;
         octet[i] = tmp;            
         i++;                    
 
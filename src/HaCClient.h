@@ -49,6 +49,32 @@
 /* #endregion */
 
 /* #region GLOBAL_DECLARATION */
+#ifndef HAC_RECONNECT_MIN_DELAY_MS
+#define HAC_RECONNECT_MIN_DELAY_MS      500     //Delay before the first retry, doubled on every failed attempt
+#endif
+
+#ifndef HAC_RECONNECT_MAX_DELAY_MS
+#define HAC_RECONNECT_MAX_DELAY_MS      60000   //Longest delay between retries
+#endif
+
+#ifndef HAC_RECONNECT_JITTER_PCT
+#define HAC_RECONNECT_JITTER_PCT        50      //Part of the delay taken off at random so devices dropped together don't retry together
+#endif
+
+/**
+     * Outbound connection state
+     * HAC_CLIENT_IDLE       : Not connected and not trying to
+     * HAC_CLIENT_CONNECTING : Host name lookup or connection in progress
+     * HAC_CLIENT_CONNECTED  : Connected
+     * HAC_CLIENT_BACKOFF    : Waiting before the next attempt(See setAutoReconnect)
+     */
+enum HaCClientState
+{
+    HAC_CLIENT_IDLE,
+    HAC_CLIENT_CONNECTING,
+    HAC_CLIENT_CONNECTED,
+    HAC_CLIENT_BACKOFF
+};
 /* #endregion */
 
 /* #region CLASS_DECLARATION */
@@ -58,53 +84,158 @@ public:
     HaCClient(); // Constructor
     ~HaCClient();   
 
-    void setup(uint16_t remotePort, const char * remoteIP); // Constructor
+    void setup(uint16_t remotePort, const char * remoteHost); // Constructor
 
-    void onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn)
+    bool onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn)
+    {
+        return HaCClientInfo::onReceive(fn);
+    }
+    bool onReceiveView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn)
     {
-        HaCClientInfo::onReceive(fn);
+        return HaCClientInfo::onReceiveView(fn);
     }
-    void onSent(std::function<void(uint16_t, HaCClientInfo*)> fn)
+    bool onSent(std::function<void(uint16_t, HaCClientInfo*)> fn)
     {
-        HaCClientInfo::onSent(fn);
+        return HaCClientInfo::onSent(fn);
     }
-    void onError(std::function<void(uint16_t, HaCClientInfo*)> fn)
+    bool onError(std::function<void(uint16_t, HaCClientInfo*)> fn)
     {
-        HaCClientInfo::onError(fn);
+        return HaCClientInfo::onError(fn);
     }
-    void onPoll(std::function<void(HaCClientInfo*)> fn)
+    bool onPoll(std::function<void(HaCClientInfo*)> fn)
     {
-        HaCClientInfo::onPoll(fn);
+        return HaCClientInfo::onPoll(fn);
     }
-    void onClosed(std::function<void(HaCClientInfo*)> fn)
+    bool onClosed(std::function<void(HaCClientInfo*)> fn)
     {
-        HaCClientInfo::onClosed(fn);
+        return HaCClientInfo::onClosed(fn);
     }
-    void onConnected(std::function<void(HaCClientInfo*)> fn)
+    bool onConnected(std::function<void(HaCClientInfo*)> fn)
     {
-        HaCClientInfo::onConnected(fn);
+        return HaCClientInfo::onConnected(fn);
     }    
-    bool connect()
+    bool onBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn)
+    {
+        return HaCClientInfo::onBufferReleased(fn);
+    }
+    bool onWritable(std::function<void(HaCClientInfo*)> fn)
+    {
+        return HaCClientInfo::onWritable(fn);
+    }
+    bool onMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn)
+    {
+        return HaCClientInfo::onMessageSent(fn);
+    }
+    bool connect();
+    void setAutoReconnect(bool enable = true, uint32_t minDelayMs = HAC_RECONNECT_MIN_DELAY_MS, 
+                          uint32_t maxDelayMs = HAC_RECONNECT_MAX_DELAY_MS);
+    HaCClientState getState() const;
+    uint16_t retryCount() const;
+    void setConnectTimeout(uint32_t timeoutMs)
+    {
+        HaCClientInfo::setConnectTimeout(timeoutMs);
+    }
+    long sendData(const char *data, HaCMessageToken *token = nullptr)
+    {
+        return HaCClientInfo::sendData(data, token);
+    }
+    long send(const void *data, size_t len, HaCMessageToken *token = nullptr)
+    {
+        return HaCClientInfo::send(data, len, token);
+    }
+    long send(const HaCSendSegment *segments, uint8_t count, HaCMessageToken *token = nullptr)
+    {
+        return HaCClientInfo::send(segments, count, token);
+    }
+    long sendNoCopy(const void *data, size_t len, HaCMessageToken *token = nullptr)
     {
-        return HaCClientInfo::connect(this->_remoteIP, this->_remotePort);    
+        return HaCClientInfo::sendNoCopy(data, len, token);
     }
-    void close(bool forceClose = false)
+    long sendShared(HaCSharedBuffer *buffer, HaCMessageToken *token = nullptr)
     {
-        HaCClientInfo::close(forceClose);
+        return HaCClientInfo::sendShared(buffer, token);
     }
-    long sendData(const char *data)
+    void cork()
     {
-        return HaCClientInfo::sendData(data);
+        HaCClientInfo::cork();
+    }
+    err_t uncork()
+    {
+        return HaCClientInfo::uncork();
+    }
+    err_t flush()
+    {
+        return HaCClientInfo::flush();
+    }
+    void setNoDelay(bool enable = true)
+    {
+        HaCClientInfo::setNoDelay(enable);
     }
     bool setPingWatchdog(bool enable = true)
     {
         return HaCClientInfo::setPingWatchdog(enable);
     }
+    bool setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs = HAC_KEEPALIVE_DEF_IDLE,
+                         uint32_t intervalMs = HAC_KEEPALIVE_DEF_INTERVAL, 
+                         uint8_t count = HAC_KEEPALIVE_DEF_COUNT)
+    {
+        return HaCClientInfo::setPingWatchdog(mode, idleMs, intervalMs, count);
+    }
+    void setIdleTimeout(uint32_t timeoutMs)
+    {
+        HaCClientInfo::setIdleTimeout(timeoutMs);
+    }
+    void setManualReceiveWindow(bool enable = true)
+    {
+        HaCClientInfo::setManualReceiveWindow(enable);
+    }
+    void consume(uint32_t len)
+    {
+        HaCClientInfo::consume(len);
+    }
+    void setSendWatermarks(uint32_t high, uint32_t low = 0)
+    {
+        HaCClientInfo::setSendWatermarks(high, low);
+    }
+    void setSlowConsumerPolicy(HaCSlowConsumerPolicy policy)
+    {
+        HaCClientInfo::setSlowConsumerPolicy(policy);
+    }
+    void setReceiveMode(HaCReceiveMode mode)
+    {
+        HaCClientInfo::setReceiveMode(mode);
+    }
+    bool setLineFraming(const char *delimiter = HAC_FRAMER_DEF_DELIMITER, 
+                        uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH)
+    {
+        return HaCClientInfo::setLineFraming(delimiter, maxLength);
+    }
+    bool setLengthPrefixFraming(HaCLengthPrefix prefix = HAC_LEN_PREFIX_U16, 
+                                uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH)
+    {
+        return HaCClientInfo::setLengthPrefixFraming(prefix, maxLength);
+    }
 
 private:    
-    tcp_pcb *_soc = nullptr;
-    ip_addr_t *_remoteIP = nullptr;
+    ip_addr_t _remoteIP;
+    char _remoteHost[HAC_DNS_MAX_HOSTNAME_LEN + 1] = {}; //Empty if the remote is an IP
     uint16_t _remotePort;
+    HaCClientState _state = HAC_CLIENT_IDLE;
+    bool _autoReconnect = false;
+    uint32_t _reconnectMinMs = HAC_RECONNECT_MIN_DELAY_MS;
+    uint32_t _reconnectMaxMs = HAC_RECONNECT_MAX_DELAY_MS;
+    uint16_t _retries = 0;
+    HaCTimer _retryTimer;
+    #ifdef HAC_ENABLE_STATIC_MEMORY
+    HaCClientCallbacks _callbackStorage; //Delegates of this client, pooled connections have none
+    #endif
+
+    bool _attempt();
+    void _retry(err_t err);
+    uint32_t _retryDelay();
+    void _onLink(err_t err);
+    static void _onLink(void *ctx, err_t err);
+    static void _onRetryTimer(void *ctx);
 
     bool _parseIP(const char *ipStr, ip_addr_t *ip);
     bool _isValidIPChar(char c);
@@ -0,0 +1,224 @@
+/**
+ *
+ * @file HaCClientPool-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/* #region SELF_HEADER */
+#include "HaCClientPool.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Library wide pool, used by every server not given a pool of its own
+     * @return Shared connection pool
+     */
+HaCClientPool& HaCClientPool::shared()
+{
+     static HaCClientPool pool;
+     return pool;
+}
+
+/**
+     * Constructor
+     */
+HaCClientPool::HaCClientPool() 
+{
+     //Lowest slot is handed out first
+     for(uint8_t i = 0; i < HAC_SERVER_MAX_SOCKET_CLIENTS; i++)
+     {
+          this->_freeList[i] = HAC_SERVER_MAX_SOCKET_CLIENTS - 1 - i;
+          this->_used[i] = false;
+          this->_owner[i] = nullptr;
+          this->_generation[i] = 1;
+     }
+     this->_freeCount = HAC_SERVER_MAX_SOCKET_CLIENTS;
+}
+
+/**
+     * Take a free slot
+     * @param owner Owner of the slot(e.g. the server accepting the connection)
+     * @return Connection slot or nullptr if the pool is full
+     */
+HaCClientInfo* HaCClientPool::acquire(const void *owner)
+{
+     if(!this->_freeCount)
+          return nullptr;
+
+     //A slot still draining its closed connection is only taken if no other one is free
+     uint8_t pick = this->_freeCount - 1;
+     for(uint8_t i = this->_freeCount; i-- > 0;)
+     {
+          if(!this->_slots[this->_freeList[i]].isDraining())
+          {
+               pick = i;
+               break;
+          }
+     }
+
+     uint8_t slot = this->_freeList[pick];
+     this->_freeList[pick] = this->_freeList[--this->_freeCount];
+     this->_used[slot] = true;
+     this->_owner[slot] = owner;
+
+     return &this->_slots[slot];
+}
+
+/**
+     * Give a slot back to the pool
+     * @param clientInfo Connection slot taken from acquire
+     */
+void HaCClientPool::release(HaCClientInfo *clientInfo)
+{
+     uint8_t slot = this->slotOf(clientInfo);
+     if(slot >= HAC_SERVER_MAX_SOCKET_CLIENTS || !this->_used[slot])
+          return;
+
+     clientInfo->reset();
+     this->_used[slot] = false;
+     this->_owner[slot] = nullptr;
+     //Stale handles of this slot stop resolving, generation 0 is skipped so a handle is never invalid
+     this->_generation[slot] = (this->_generation[slot] + 1) & (0xFFFFFFFFUL >> HAC_CONNECTION_HANDLE_SLOT_BITS);
+     if(!this->_generation[slot])
+          this->_generation[slot] = 1;
+     this->_freeList[this->_freeCount++] = slot;
+}
+
+/**
+     * Number of slots
+     * @return Pool capacity
+     */
+uint8_t HaCClientPool::capacity() const
+{
+     return HAC_SERVER_MAX_SOCKET_CLIENTS;
+}
+
+/**
+     * Number of slots in use
+     * @return Used slot count
+     */
+uint8_t HaCClientPool::used() const
+{
+     return HAC_SERVER_MAX_SOCKET_CLIENTS - this->_freeCount;
+}
+
+/**
+     * Number of slots taken by an owner
+     * @param owner Slot owner, nullptr for every owner
+     * @return Used slot count
+     */
+uint8_t HaCClientPool::used(const void *owner) const
+{
+     if(!owner)
+          return this->used();
+
+     uint8_t count = 0;
+     for(uint8_t i = 0; i < HAC_SERVER_MAX_SOCKET_CLIENTS; i++)
+     {
+          if(this->_used[i] && this->_owner[i] == owner)
+               count++;
+     }
+
+     return count;
+}
+
+/**
+     * Check if a slot is in use
+     * @param slot Slot index
+     * @return True if the slot holds a connection
+     */
+bool HaCClientPool::isUsed(uint8_t slot) const
+{
+     return slot < HAC_SERVER_MAX_SOCKET_CLIENTS && this->_used[slot];
+}
+
+/**
+     * Check if a slot is in use by an owner
+     * @param slot Slot index
+     * @param owner Slot owner, nullptr for every owner
+     * @return True if the slot holds a connection of the owner
+     */
+bool HaCClientPool::isUsedBy(uint8_t slot, const void *owner) const
+{
+     return this->isUsed(slot) && (!owner || this->_owner[slot] == owner);
+}
+
+/**
+     * Get a slot
+     * @param slot Slot index
+     * @return Connection slot
+     */
+HaCClientInfo* HaCClientPool::at(uint8_t slot)
+{
+     return &this->_slots[slot];
+}
+
+/**
+     * Slot index of a connection
+     * @param clientInfo Connection slot
+     * @return Slot index or HAC_SERVER_MAX_SOCKET_CLIENTS if it is not from this pool
+     */
+uint8_t HaCClientPool::slotOf(const HaCClientInfo *clientInfo) const
+{
+     if(clientInfo < &this->_slots[0] || clientInfo >= &this->_slots[HAC_SERVER_MAX_SOCKET_CLIENTS])
+          return HAC_SERVER_MAX_SOCKET_CLIENTS;
+
+     return (uint8_t)(clientInfo - &this->_slots[0]);
+}
+
+/**
+     * Handle of a connection
+     * @param clientInfo Connection slot
+     * @return Slot index and generation or HAC_CONNECTION_HANDLE_INVALID if the slot is not in use
+     */
+HaCConnectionHandle HaCClientPool::handleOf(const HaCClientInfo *clientInfo) const
+{
+     uint8_t slot = this->slotOf(clientInfo);
+     if(!this->isUsed(slot))
+          return HAC_CONNECTION_HANDLE_INVALID;
+
+     return (this->_generation[slot] << HAC_CONNECTION_HANDLE_SLOT_BITS) | slot;
+}
+
+/**
+     * Look up a connection by handle
+     * @param handle Connection handle
+     * @param owner Slot owner, nullptr for every owner
+     * @return Connection or nullptr if the handle is stale, invalid or of another owner
+     */
+HaCClientInfo* HaCClientPool::find(HaCConnectionHandle handle, const void *owner)
+{
+     uint8_t slot = HAC_CONNECTION_HANDLE_SLOT(handle);
+     if(!this->isUsedBy(slot, owner) || this->_generation[slot] != HAC_CONNECTION_HANDLE_GEN(handle))
+          return nullptr;
+
+     return &this->_slots[slot];
+}
+
+/* #endregion */
+
+/* #endregion */
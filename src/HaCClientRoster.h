@@ -0,0 +1,92 @@
+/**
+ *
+ * @file HaCClientRoster.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#ifndef __HAC_CLIENTROSTER_H_
+#define __HAC_CLIENTROSTER_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCClientPool.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Non owning view of the live connections of a pool, optionally only the ones of one owner.
+     * Iterating walks the pool slots in place, nothing is copied or allocated. 
+     * Only valid for the duration of the callback it was given to.
+     */
+class HaCClientRoster
+{
+    public:
+        class Iterator
+        {
+            public:
+                Iterator(const HaCClientRoster *roster, uint8_t slot);
+                HaCClientInfo* operator*() const;
+                Iterator& operator++();
+                bool operator!=(const Iterator &other) const;
+
+            private:
+                const HaCClientRoster *_roster;
+                uint8_t _slot;
+
+                void _skip();
+        };
+
+        HaCClientRoster(HaCClientPool *pool, const HaCClientInfo *exclude = nullptr, const void *owner = nullptr);
+
+        Iterator begin() const;
+        Iterator end() const;
+        uint8_t size() const;
+        bool empty() const;
+
+    private:
+        HaCClientPool *_pool;
+        const HaCClientInfo *_exclude;
+        const void *_owner;
+
+        bool _listed(uint8_t slot) const;
+};
+/* #endregion */
+
+#include "HaCClientRoster-impl.h"
+
+#endif
@@ -0,0 +1,229 @@
+/**
+ *
+ * @file HaCDnsCache-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+
+
+/* #region SELF_HEADER */
+#include "HaCDnsCache.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Library wide cache
+     * @return DNS cache
+     */
+HaCDnsCache& HaCDnsCache::instance()
+{
+     static HaCDnsCache cache;
+     return cache;
+}
+
+/**
+     * Set how long a resolved address is reused, the same for every host whatever its record TTL
+     * @param ttlMs Time in ms, 0 to ask lwIP on every lookup
+     */
+void HaCDnsCache::setTtl(uint32_t ttlMs)
+{
+     this->_ttlMs = ttlMs;
+}
+
+/**
+     * Resolve a host name without blocking
+     * @param host Host name, up to HAC_DNS_MAX_HOSTNAME_LEN characters
+     * @param ip Receives the address if it is known right away
+     * @param fn Called with the address, or nullptr if the lookup failed, once ERR_INPROGRESS is returned
+     * @param ctx Passed back to fn, also used to cancel the wait
+     * @return ERR_OK if ip is set, ERR_INPROGRESS if fn will be called, an error otherwise
+     */
+err_t HaCDnsCache::resolve(const char *host, ip_addr_t *ip, HaCDnsFoundFn fn, void *ctx)
+{
+     if(!host || !*host || strlen(host) > HAC_DNS_MAX_HOSTNAME_LEN || !ip || !fn)
+          return ERR_ARG;
+
+     HaCDnsEntry *entry = this->_entry(host);
+     if(!entry)
+          return ERR_MEM;
+
+     if(this->_isFresh(entry))
+     {
+          *ip = entry->ip;
+          return ERR_OK;
+     }
+
+     HaCDnsWaiter *waiter = nullptr;
+     for(uint8_t i = 0; i < HAC_DNS_MAX_WAITERS && !waiter; i++)
+     {
+          if(!this->_waiters[i].entry)
+               waiter = &this->_waiters[i];
+     }
+     if(!waiter)
+          return ERR_MEM;
+
+     //Already asked for by another connection
+     if(!entry->pending)
+     {
+          err_t err = dns_gethostbyname(entry->host, &entry->ip, &HaCDnsCache::_found, entry);
+          if(err == ERR_OK)
+          {
+               entry->resolved = true;
+               entry->resolvedMs = millis();
+               *ip = entry->ip;
+               return ERR_OK;
+          }
+
+          if(err != ERR_INPROGRESS)
+          {
+               entry->resolved = false;
+               return err;
+          }
+
+          entry->pending = true;
+     }
+
+     waiter->entry = entry;
+     waiter->fn = fn;
+     waiter->ctx = ctx;
+     return ERR_INPROGRESS;
+}
+
+/**
+     * Stop waiting for a lookup, the lookup itself goes on and is cached
+     * @param ctx Context given to resolve
+     */
+void HaCDnsCache::cancel(void *ctx)
+{
+     for(uint8_t i = 0; i < HAC_DNS_MAX_WAITERS; i++)
+     {
+          if(this->_waiters[i].entry && this->_waiters[i].ctx == ctx)
+               this->_waiters[i].entry = nullptr;
+     }
+}
+
+/**
+     * Forget every resolved address(e.g. after the network changed)
+     */
+void HaCDnsCache::flush()
+{
+     for(uint8_t i = 0; i < HAC_DNS_CACHE_SIZE; i++)
+          this->_entries[i].resolved = false;
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Constructor
+     */
+HaCDnsCache::HaCDnsCache()
+{
+}
+
+/**
+     * Entry of a host, a new one takes the place of the oldest entry not being looked up
+     * @param host Host name
+     * @return Entry or nullptr if every entry is being looked up
+     */
+HaCDnsCache::HaCDnsEntry* HaCDnsCache::_entry(const char *host)
+{
+     HaCDnsEntry *entry = nullptr;
+     for(uint8_t i = 0; i < HAC_DNS_CACHE_SIZE; i++)
+     {
+          HaCDnsEntry *e = &this->_entries[i];
+          if(e->host[0] && !strcmp(e->host, host))
+               return e;
+
+          if(e->pending)
+               continue;
+          if(!entry || !e->host[0] || (entry->host[0] && (int32_t)(e->resolvedMs - entry->resolvedMs) < 0))
+               entry = e;
+     }
+
+     if(entry)
+     {
+          strcpy(entry->host, host);
+          entry->resolved = false;
+     }
+
+     return entry;
+}
+
+/**
+     * Check if the address of an entry can still be used
+     * @param entry Entry
+     * @return True if it is resolved and younger than the TTL
+     */
+bool HaCDnsCache::_isFresh(const HaCDnsEntry *entry) const
+{
+     return entry->resolved && millis() - entry->resolvedMs < this->_ttlMs;
+}
+
+/**
+     * Lookup done, cache the address and hand it to the waiting connections
+     * @param entry Entry looked up
+     * @param ip Address or nullptr if the lookup failed
+     */
+void HaCDnsCache::_found(HaCDnsEntry *entry, const ip_addr_t *ip)
+{
+     entry->pending = false;
+     entry->resolved = ip != nullptr;
+     if(ip)
+     {
+          entry->ip = *ip;
+          entry->resolvedMs = millis();
+     }
+     DBG_CB_HSOC2("\n[HACDNSCACHE] %s %s\n", entry->host, ip ? "resolved" : "not resolved");
+
+     for(uint8_t i = 0; i < HAC_DNS_MAX_WAITERS; i++)
+     {
+          HaCDnsWaiter waiter = this->_waiters[i];
+          if(waiter.entry != entry)
+               continue;
+
+          //Freed first, the callback may start a new lookup
+          this->_waiters[i].entry = nullptr;
+          waiter.fn(waiter.ctx, ip ? &entry->ip : nullptr);
+     }
+}
+
+/**
+     * lwIP lookup callback
+     * @param name Host name
+     * @param ip Address or nullptr if the lookup failed
+     * @param arg Entry looked up
+     */
+void HaCDnsCache::_found(const char *name, const ip_addr_t *ip, void *arg)
+{
+     HaCDnsCache::instance()._found(reinterpret_cast<HaCDnsEntry*>(arg), ip);
+}
+
+/* #endregion */
+
+/* #endregion */
@@ -36,6 +36,12 @@
      */
 HaCEspSockets::HaCEspSockets()
 {
+     //Always handled, the clients are owned here and must not delete themselves on close
+     this->_clientCallbacks.onClosed = [this](HaCClientInfo *clientInfo)
+          {
+               if(this->_clientOnSocketClosedFn)
+                    this->_clientOnSocketClosedFn(clientInfo);
+          };
 }
 
 /**
@@ -43,99 +49,516 @@ HaCEspSockets::HaCEspSockets()
      */
 HaCEspSockets::~HaCEspSockets()
 {
-     if(this->_socketServer != nullptr)     
-          delete this->_socketServer;
-     if(this->_socketClient != nullptr)     
-          delete this->_socketClient;
+     //Queued no-copy buffers are handed back before the clients go
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->abort();
+     }
+
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+          delete this->_servers[i];
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+          delete this->_clients[i];
+     #endif
 
 }
 
 /**
-     * Setup Socket Server
+     * Setup Socket Server, calling it again moves the server to the new port
      * @param port Socket server listening port
      */
 void HaCEspSockets::setupServer(uint16_t port)
 {
      DBG_CB_HSOC("[HACESPSOCKETS] Setting up the socket server..");
-     this->_socketServer = new HaCServer();
-     this->_serverListenPort = port;
-     this->_socketServer->setup(this->_serverListenPort);       
+     if(this->_servers[0])
+          this->_servers[0]->stop();
+     else if(!this->_createServer(0))
+          return;
+
+     this->_servers[0]->setup(port);       
      DBG_CB_HSOC("[HACESPSOCKETS] Server is listening..");
+}
+
+/**
+     * Setup one more Socket Server, it shares the connection pool, the settings 
+     * and the events of the other servers(See HaCClientInfo::getLocalPort)
+     * @param port Socket server listening port
+     * @return Server or nullptr if HAC_SOCKETS_MAX_SERVERS are set up
+     */
+HaCServer* HaCEspSockets::addServer(uint16_t port)
+{
+     if(this->getServer(port))
+          return nullptr;
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               continue;
+
+          HaCServer *server = this->_createServer(i);
+          if(server)
+               server->setup(port);
+          return server;
+     }
+
+     return nullptr;
+}
+
+/**
+     * Server listening on a port
+     * @param port Socket server listening port
+     * @return Server or nullptr if none is set up on the port
+     */
+HaCServer* HaCEspSockets::getServer(uint16_t port)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i] && this->_servers[i]->getPort() == port)
+               return this->_servers[i];
+     }
+
+     return nullptr;
+}
 
-     this->_socketServer->onNewConnection(this->_server_onNewClientConnectionFn);
-     this->_socketServer->onReceive(this->_server_clientOnDataArrivalFn);
-     this->_socketServer->onClosed(this->_server_clientOnSocketClosedFn);
-     this->_socketServer->onSent(this->_server_clientOnDataSentFn);
-     this->_socketServer->onError(this->_server_clientOnSocketErrorFn);
-     this->_socketServer->onPoll(this->_server_clientOnPollFn);
+/**
+     * Shutdown a server and free its slot
+     * @param port Socket server listening port
+     * @return False if no server is set up on the port
+     */
+bool HaCEspSockets::removeServer(uint16_t port)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(!this->_servers[i] || this->_servers[i]->getPort() != port)
+               continue;
+
+          this->_servers[i]->stop();
+          #ifndef HAC_ENABLE_STATIC_MEMORY
+          delete this->_servers[i];
+          #endif
+          this->_servers[i] = nullptr;
+          return true;
+     }
+
+     return false;
 }
 
 /**
-     * Start Server function.
+     * Start Server function, every server set up is started.
      */
 void HaCEspSockets::startServer()
 {     
-     if(this->_socketServer)
-          this->_socketServer->start();
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->start();
+     }
 
      DBG_CB_HSOC("[HACESPSOCKETS] Server started..");
 }
 
 /**
-     * Shutdown Socket Server
+     * Shutdown Socket Server, every server set up is stopped
      */
 void HaCEspSockets::shutdownServer()
 {
-     if(this->_socketServer)
-          this->_socketServer->stop();
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->stop();
+     }
      
      DBG_CB_HSOC("[HACESPSOCKETS] Server Shutdown..");
 }
 
 /**
-     * Server broadcast message to all connected client
+     * Server broadcast message to all connected client of every server
      * @param message data message
      */
 void HaCEspSockets::ServerBroadCast(const char *message)
 {
-     if(this->_socketServer)
-          this->_socketServer->broadCastMessage(message);
+     this->ServerBroadCast(message, strlen(message));
 }
 
 /**
-     * Server broadcast message to all connected client
-     * @param message data message
+     * Server broadcast binary data to all connected client of every server(See HaCServer::broadCastMessage)
+     * @param data data to be sent
+     * @param len data length
+     */
+void HaCEspSockets::ServerBroadCast(const void *data, size_t len)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->broadCastMessage(data, len);
+     }
+}
+
+/**
+     * Server send data to one connected client
+     * @param handle Client connection handle
+     * @param data data to be sent
+     * @param len data length
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return Send result or ERR_CONN if the client is gone
+     */
+long HaCEspSockets::ServerSend(HaCConnectionHandle handle, const void *data, size_t len, HaCMessageToken *token)
+{
+     HaCClientInfo *client = this->ServerGetClient(handle);
+     if(!client)
+     {
+          if(token)
+               *token = HAC_MESSAGE_TOKEN_INVALID;
+          return ERR_CONN;
+     }
+
+     return client->send(data, len, token);
+}
+
+/**
+     * Server get a connected client
+     * @param handle Client connection handle
+     * @return Client connection or nullptr if it is gone
+     */
+HaCClientInfo* HaCEspSockets::ServerGetClient(HaCConnectionHandle handle)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          HaCClientInfo *client = this->_servers[i] ? this->_servers[i]->getClient(handle) : nullptr;
+          if(client)
+               return client;
+     }
+
+     return nullptr;
+}
+
+/**
+     * Server limit the number of connections
+     * @param maxClients Maximum connections, limited to HAC_SERVER_MAX_SOCKET_CLIENTS, 0 for the full pool
+     */
+void HaCEspSockets::ServerSetMaxClients(uint8_t maxClients)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setMaxClients(maxClients);
+     }
+}
+
+/**
+     * Server listen backlog, call it before startServer
+     * @param backlog Connections lwIP holds pending before accepting them
+     */
+void HaCEspSockets::ServerSetBacklog(uint8_t backlog)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setBacklog(backlog);
+     }
+}
+
+/**
+     * Server set what happens to a connection arriving while the server is full
+     * @param policy HAC_ADMISSION_REFUSE or HAC_ADMISSION_BUSY_FRAME
+     * @param retryAfterMs Retry delay announced by the busy frame
+     */
+void HaCEspSockets::ServerSetAdmissionPolicy(HaCAdmissionPolicy policy, uint32_t retryAfterMs)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setAdmissionPolicy(policy, retryAfterMs);
+     }
+}
+
+/**
+     * Enable the ping watchdog of the server connections and the clients
+     * @param enable True to enable
+     * @return Return watchdog enable state
      */
 bool HaCEspSockets::setPingWatchdog(bool enable)
 {
-     if(this->_socketServer)
-          return this->_socketServer->setPingWatchdog(enable);
+     bool enabled = false;
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               enabled = this->_servers[i]->setPingWatchdog(enable);
+     }
 
-     if(this->_socketClient)
-          return this->_socketClient->setPingWatchdog(enable);
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               enabled = this->_clients[i]->setPingWatchdog(enable);
+     }
 
-     return false;
+     return enabled;
+}
+
+/**
+     * Close the server connections or the client once idle for a while
+     * @param timeoutMs Idle time in ms, 0 to disable
+     */
+void HaCEspSockets::setIdleTimeout(uint32_t timeoutMs)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setIdleTimeout(timeoutMs);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setIdleTimeout(timeoutMs);
+     }
 }
 
+/**
+     * Let the application open the receive window of the server connections or the client
+     * @param enable True to open the window with consume, false to open it on receive(Default)
+     */
+void HaCEspSockets::setManualReceiveWindow(bool enable)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setManualReceiveWindow(enable);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setManualReceiveWindow(enable);
+     }
+}
 
 /**
-     * Setup a client socket
-     * @param message data message
+     * Limit the unacknowledged data of the server connections or the client
+     * @param high Unacknowledged bytes before a connection is a slow consumer, 0 to disable
+     * @param low Unacknowledged bytes before the writable event is raised, 0 for half of high
+     */
+void HaCEspSockets::setSendWatermarks(uint32_t high, uint32_t low)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setSendWatermarks(high, low);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setSendWatermarks(high, low);
+     }
+}
+
+/**
+     * Set what happens to new data for a connection at its send high watermark
+     * @param policy HAC_SLOW_CONSUMER_DROP_NEWEST, HAC_SLOW_CONSUMER_DROP_OLDEST or HAC_SLOW_CONSUMER_DISCONNECT
+     */
+void HaCEspSockets::setSlowConsumerPolicy(HaCSlowConsumerPolicy policy)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setSlowConsumerPolicy(policy);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setSlowConsumerPolicy(policy);
+     }
+}
+
+/**
+     * Turn the Nagle algorithm off on the server connections or the client
+     * @param enable True to disable Nagle
+     */
+void HaCEspSockets::setNoDelay(bool enable)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_servers[i]->setNoDelay(enable);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setNoDelay(enable);
+     }
+}
+
+/**
+     * Hold back new connections, receive windows and broadcasts while the free heap is low
+     * @param minAccept Free heap below which new connections are refused, 0 to disable
+     * @param minReceive Free heap below which receive windows stay closed, 0 to disable
+     * @param minBroadcast Free heap below which broadcasts are dropped, 0 to disable
+     */
+void HaCEspSockets::setHeapThresholds(uint32_t minAccept, uint32_t minReceive, uint32_t minBroadcast)
+{
+     HaCMemoryGovernor::instance().setThresholds(minAccept, minReceive, minBroadcast);
+}
+
+/**
+     * Set how long a resolved host name is reused by the clients
+     * @param ttlMs Time in ms, 0 to resolve on every connect
+     */
+void HaCEspSockets::setDnsCacheTtl(uint32_t ttlMs)
+{
+     HaCDnsCache::instance().setTtl(ttlMs);
+}
+
+/**
+     * Reopen the client receive window for consumed data
+     * @param len Number of bytes consumed
+     */
+void HaCEspSockets::clientConsume(uint32_t len)
+{
+     if(this->_clients[0])
+          this->_clients[0]->consume(len);
+}
+
+/**
+     * Set the dead peer detection mode of the server connections or the client
+     * @param mode HAC_WATCHDOG_OFF, HAC_WATCHDOG_PING or HAC_WATCHDOG_KEEPALIVE
+     * @param idleMs Keepalive only, idle time before the first probe
+     * @param intervalMs Keepalive only, time between probes
+     * @param count Keepalive only, unanswered probes before the connection is dropped
+     * @return Return watchdog enable state
+     */
+bool HaCEspSockets::setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs, uint32_t intervalMs, uint8_t count)
+{
+     bool enabled = false;
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               enabled = this->_servers[i]->setPingWatchdog(mode, idleMs, intervalMs, count);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               enabled = this->_clients[i]->setPingWatchdog(mode, idleMs, intervalMs, count);
+     }
+
+     return enabled;
+}
+
+/**
+     * Set the receive data mode of the server connections and the client
+     * @param mode HAC_RX_MODE_TEXT, HAC_RX_MODE_BINARY, HAC_RX_MODE_DELIMITED or HAC_RX_MODE_LENGTH_PREFIXED
+     */
+void HaCEspSockets::setReceiveMode(HaCReceiveMode mode)
+{
+     this->_receiveMode = mode;
+     this->_applyReceiveMode();
+}
+
+/**
+     * Enable delimiter framing on the server connections and the client
+     * @param delimiter Line delimiter(Must stay valid), up to HAC_FRAMER_MAX_DELIMITER_LEN characters
+     * @param maxLength Maximum line length, longer lines are dropped
+     */
+void HaCEspSockets::setLineFraming(const char *delimiter, uint16_t maxLength)
+{
+     this->_frameDelimiter = delimiter;
+     this->_maxFrameLength = maxLength;
+     this->_receiveMode = HAC_RX_MODE_DELIMITED;
+     this->_applyReceiveMode();
+}
+
+/**
+     * Enable length prefixed framing on the server connections and the client
+     * @param prefix HAC_LEN_PREFIX_VARINT, HAC_LEN_PREFIX_U16 or HAC_LEN_PREFIX_U32
+     * @param maxLength Maximum frame length, longer frames are skipped
+     */
+void HaCEspSockets::setLengthPrefixFraming(HaCLengthPrefix prefix, uint16_t maxLength)
+{
+     this->_lengthPrefix = prefix;
+     this->_maxFrameLength = maxLength;
+     this->_receiveMode = HAC_RX_MODE_LENGTH_PREFIXED;
+     this->_applyReceiveMode();
+}
+
+
+/**
+     * Setup a client socket, calling it again moves the client to the new remote
+     * @param remotePort Remote server port
+     * @param remoteIP Remote server IP or host name
      */
 void HaCEspSockets::setupClient(uint16_t remotePort, const char * remoteIP)
 {    
      
      DBG_CB_HSOC("[HACESPSOCKETS] Setting up the client socket..");     
-     this->_socketClient = new HaCClient(); 
-
-     this->_socketClient->onReceive(this->_clientOnDataArrivalFn);
-     this->_socketClient->onSent(this->_clientOnDataSentFn);
-     this->_socketClient->onError(this->_server_clientOnSocketErrorFn);
-     this->_socketClient->onPoll(this->_clientOnPollFn);
-     this->_socketClient->onClosed(this->_clientOnSocketClosedFn);
-     this->_socketClient->onConnected(this->_clientOnConnectedFn);
+     if(this->_clients[0])
+          this->_clients[0]->close(true);
+     else if(!this->_createClient(0))
+          return;
      
-     this->_socketClient->setup(remotePort, remoteIP);
+     this->_clients[0]->setup(remotePort, remoteIP);
+}
+
+/**
+     * Setup one more client socket, it shares the settings and the events of the other clients
+     * @param remotePort Remote server port
+     * @param remoteIP Remote server IP or host name
+     * @return Client or nullptr if HAC_SOCKETS_MAX_CLIENTS are set up
+     */
+HaCClient* HaCEspSockets::addClient(uint16_t remotePort, const char * remoteIP)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               continue;
+
+          HaCClient *client = this->_createClient(i);
+          if(client)
+               client->setup(remotePort, remoteIP);
+          return client;
+     }
+
+     return nullptr;
+}
+
+/**
+     * Get an outbound client
+     * @param index Client index, 0 is the one of setupClient
+     * @return Client or nullptr if none is set up at the index
+     */
+HaCClient* HaCEspSockets::getOutboundClient(uint8_t index)
+{
+     if(index >= HAC_SOCKETS_MAX_CLIENTS)
+          return nullptr;
+
+     return this->_clients[index];
+}
+
+/**
+     * Close a client and free its slot
+     * @param client Client returned by addClient or getOutboundClient
+     * @return False if the client is not owned here
+     */
+bool HaCEspSockets::removeClient(HaCClient *client)
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(!client || this->_clients[i] != client)
+               continue;
+
+          client->close(true);
+          #ifndef HAC_ENABLE_STATIC_MEMORY
+          delete client;
+          #endif
+          this->_clients[i] = nullptr;
+          return true;
+     }
+
+     return false;
 }
 
 /**
@@ -143,22 +566,110 @@ void HaCEspSockets::setupClient(uint16_t remotePort, const char * remoteIP)
      */
 void HaCEspSockets::clientClose()
 {    
-     this->_socketClient->close(true);
+     if(this->_clients[0])
+          this->_clients[0]->close(true);
 }
 
 /**
-     * Client Send data
+     * Client Send data, a message bigger than the free socket send buffer plus 
+     * HAC_SOCCLIENT_TX_BUFFER_SIZE returns ERR_MEM and has to be sent in parts
      * @param message data message
+     * @param token Optional, receives the message token reported by onMessageSent
      * @return Send error state
      */
-long HaCEspSockets::clientSend(const char *message)
+long HaCEspSockets::clientSend(const char *message, HaCMessageToken *token)
 {
-     if(!this->_socketClient) return (long)0;
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
 
-     return this->_socketClient->sendData(message);
+     if(!this->_clients[0]) return (long)0;
+
+     return this->_clients[0]->sendData(message, token);
      
 }
 
+/**
+     * Client Send binary data
+     * @param data data to be sent
+     * @param len data length
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return Send error state, ERR_CONN if no client is set up
+     */
+long HaCEspSockets::clientSend(const void *data, size_t len, HaCMessageToken *token)
+{
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_clients[0]) return ERR_CONN;
+
+     return this->_clients[0]->send(data, len, token);
+}
+
+/**
+     * Client Send several buffers back to back
+     * @param segments buffers to be sent
+     * @param count number of buffers
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return Send error state, ERR_CONN if no client is set up
+     */
+long HaCEspSockets::clientSend(const HaCSendSegment *segments, uint8_t count, HaCMessageToken *token)
+{
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_clients[0]) return ERR_CONN;
+
+     return this->_clients[0]->send(segments, count, token);
+}
+
+/**
+     * Client Send data without copying it
+     * @param data data to be sent, must stay untouched until clientOnBufferReleased
+     * @param len data length
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return Send error state, ERR_CONN if no client is set up
+     */
+long HaCEspSockets::clientSendNoCopy(const void *data, size_t len, HaCMessageToken *token)
+{
+     if(token)
+          *token = HAC_MESSAGE_TOKEN_INVALID;
+
+     if(!this->_clients[0]) return ERR_CONN;
+
+     return this->_clients[0]->sendNoCopy(data, len, token);
+}
+
+/**
+     * Client hint that more sends follow until clientUncork(See HaCClientInfo::cork)
+     */
+void HaCEspSockets::clientCork()
+{
+     if(this->_clients[0])
+          this->_clients[0]->cork();
+}
+
+/**
+     * Client end the batch started by clientCork and transmit the queued data
+     * @return Send error state, ERR_CONN if no client is set up
+     */
+long HaCEspSockets::clientUncork()
+{
+     if(!this->_clients[0]) return ERR_CONN;
+
+     return this->_clients[0]->uncork();
+}
+
+/**
+     * Client transmit the queued data right away
+     * @return Send error state, ERR_CONN if no client is set up
+     */
+long HaCEspSockets::clientFlush()
+{
+     if(!this->_clients[0]) return ERR_CONN;
+
+     return this->_clients[0]->flush();
+}
+
 /**
      * Client Connect
      * @param message data message  
@@ -166,7 +677,53 @@ long HaCEspSockets::clientSend(const char *message)
      */
 bool HaCEspSockets::clientConnect()
 {
-     return this->_socketClient->connect();     
+     if(!this->_clients[0]) return false;
+
+     return this->_clients[0]->connect();     
+}
+
+/**
+     * Let the clients reconnect by themselves with capped exponential backoff and jitter,
+     * applied to the clients set up later too
+     * @param enable True to reconnect, clientClose stops it
+     * @param minDelayMs Delay before the first retry
+     * @param maxDelayMs Longest delay between retries
+     */
+void HaCEspSockets::clientSetAutoReconnect(bool enable, uint32_t minDelayMs, uint32_t maxDelayMs)
+{
+     this->_clientAutoReconnect = enable;
+     this->_clientReconnectMinMs = minDelayMs;
+     this->_clientReconnectMaxMs = maxDelayMs;
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setAutoReconnect(enable, minDelayMs, maxDelayMs);
+     }
+}
+
+/**
+     * Give up a client connect attempt after a while, applied to the clients set up later too
+     * @param timeoutMs Time in ms, 0 for HAC_SOCCLIENT_CONNECT_TIMEOUT_MS
+     */
+void HaCEspSockets::clientSetConnectTimeout(uint32_t timeoutMs)
+{
+     this->_clientConnectTimeoutMs = timeoutMs;
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_clients[i]->setConnectTimeout(timeoutMs);
+     }
+}
+
+/**
+     * Client connection state
+     * @return HAC_CLIENT_IDLE, HAC_CLIENT_CONNECTING, HAC_CLIENT_CONNECTED or HAC_CLIENT_BACKOFF
+     */
+HaCClientState HaCEspSockets::clientState()
+{
+     if(!this->_clients[0]) return HAC_CLIENT_IDLE;
+
+     return this->_clients[0]->getState();
 }
 
 /* #region Event functions(Client Events) */
@@ -177,7 +734,16 @@ bool HaCEspSockets::clientConnect()
      */
 void HaCEspSockets::clientOnDataArrival(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn)
 {
-     this->_clientOnDataArrivalFn = fn;
+     this->_clientCallbacks.onReceive = fn;
+}
+
+/**
+     * clientOnDataView Delegate function.           
+     * @param fn clientOnDataView Callback function.
+     */
+void HaCEspSockets::clientOnDataView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn)
+{
+     this->_clientCallbacks.onReceiveView = fn;
 }
 
 /**
@@ -186,7 +752,7 @@ void HaCEspSockets::clientOnDataArrival(std::function<void(HaCClientInfo*, const
      */
 void HaCEspSockets::clientOnDataSent(std::function<void(uint16_t, HaCClientInfo*)> fn)
 {
-     this->_clientOnDataSentFn = fn;
+     this->_clientCallbacks.onSent = fn;
 }
 
 /**
@@ -195,7 +761,7 @@ void HaCEspSockets::clientOnDataSent(std::function<void(uint16_t, HaCClientInfo*
      */
 void HaCEspSockets::clientOnSocketError(std::function<void(uint16_t, HaCClientInfo*)> fn)
 {
-     this->_clientOnSocketErrorFn = fn;
+     this->_clientCallbacks.onError = fn;
 }
 
 /**
@@ -204,7 +770,7 @@ void HaCEspSockets::clientOnSocketError(std::function<void(uint16_t, HaCClientIn
      */
 void HaCEspSockets::clientOnPoll(std::function<void(HaCClientInfo*)> fn)
 {
-     this->_clientOnPollFn = fn;
+     this->_clientCallbacks.onPoll = fn;
 }
 
 /**
@@ -217,12 +783,39 @@ void HaCEspSockets::clientOnSocketClosed(std::function<void(HaCClientInfo*)> fn)
 }
 
 /**
-     * clientOnSocketClosed Delegate function.           
-     * @param fn clientOnSocketClosed Callback function.
+     * clientOnConnected Delegate function.           
+     * @param fn clientOnConnected Callback function.
      */
 void HaCEspSockets::clientOnConnected(std::function<void(HaCClientInfo*)> fn)
 {
-     this->_clientOnConnectedFn = fn;
+     this->_clientCallbacks.onConnected = fn;
+}
+
+/**
+     * clientOnBufferReleased Delegate function.           
+     * @param fn clientOnBufferReleased Callback function.
+     */
+void HaCEspSockets::clientOnBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn)
+{
+     this->_clientCallbacks.onBufferReleased = fn;
+}
+
+/**
+     * clientOnWritable Delegate function.           
+     * @param fn clientOnWritable Callback function.
+     */
+void HaCEspSockets::clientOnWritable(std::function<void(HaCClientInfo*)> fn)
+{
+     this->_clientCallbacks.onWritable = fn;
+}
+
+/**
+     * clientOnMessageSent Delegate function.           
+     * @param fn clientOnMessageSent Callback function.
+     */
+void HaCEspSockets::clientOnMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn)
+{
+     this->_clientCallbacks.onMessageSent = fn;
 }
 
 /* #endregion */
@@ -239,6 +832,15 @@ void HaCEspSockets::Server_clientOnDataArrival(std::function<void(HaCClientInfo*
      this->_server_clientOnDataArrivalFn = fn;
 }
 
+/**
+     * Server_clientOnDataView Delegate function.           
+     * @param fn Server_clientOnDataView Callback function.
+     */
+void HaCEspSockets::Server_clientOnDataView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn)
+{
+     this->_server_clientOnDataViewFn = fn;
+}
+
 /**
      * Server_clientOnSent Delegate function.           
      * @param fn Server_clientOnSent Callback function.
@@ -266,8 +868,37 @@ void HaCEspSockets::Server_clientOnPoll(std::function<void(HaCClientInfo*)> fn)
      this->_server_clientOnPollFn = fn;
 }
 
+/**
+     * Server_clientOnBufferReleased Delegate function.           
+     * @param fn Server_clientOnBufferReleased Callback function.
+     */
+void HaCEspSockets::Server_clientOnBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn)
+{
+     this->_server_clientOnBufferReleasedFn = fn;
+}
+
+/**
+     * Server_clientOnWritable Delegate function.           
+     * @param fn Server_clientOnWritable Callback function.
+     */
+void HaCEspSockets::Server_clientOnWritable(std::function<void(HaCClientInfo*)> fn)
+{
+     this->_server_clientOnWritableFn = fn;
+}
+
+/**
+     * Server_clientOnMessageSent Delegate function.           
+     * @param fn Server_clientOnMessageSent Callback function.
+     */
+void HaCEspSockets::Server_clientOnMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn)
+{
+     this->_server_clientOnMessageSentFn = fn;
+}
+
+#ifndef HAC_ENABLE_STATIC_MEMORY
 /**
      * Server_clientOnClosed Delegate function.           
+     * Not available with HAC_ENABLE_STATIC_MEMORY(See Server_onClientLeft).
      * @param fn Server_clientOnClosed Callback function.
      */
 void HaCEspSockets::Server_clientOnSocketClosed(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn)
@@ -277,18 +908,140 @@ void HaCEspSockets::Server_clientOnSocketClosed(std::function<void(HaCClientInfo
 
 /**
      * Server_onNewClientConnection Delegate function.           
+     * Not available with HAC_ENABLE_STATIC_MEMORY(See Server_onClientJoined).
      * @param fn Server_onNewClientConnection Callback function.
      */
 void HaCEspSockets::Server_onNewClientConnection(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn)
 {     
      this->_server_onNewClientConnectionFn = fn;
 }
+#endif
+
+/**
+     * Server_onClientJoined Delegate function.           
+     * @param fn Server_onClientJoined Callback function.
+     */
+void HaCEspSockets::Server_onClientJoined(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn)
+{     
+     this->_server_onClientJoinedFn = fn;
+}
+
+/**
+     * Server_onClientLeft Delegate function.           
+     * @param fn Server_onClientLeft Callback function.
+     */
+void HaCEspSockets::Server_onClientLeft(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn)
+{     
+     this->_server_onClientLeftFn = fn;
+}
 
 /* #endregion */
 
 /* #endregion */
 
 /* #region Private */
+
+/**
+     * Create a server with the events set so far
+     * @param index Server slot
+     * @return Server
+     */
+HaCServer* HaCEspSockets::_createServer(uint8_t index)
+{
+     #ifdef HAC_ENABLE_STATIC_MEMORY
+     HaCServer *server = &this->_serverStorage[index];
+     #else
+     HaCServer *server = new HaCServer();
+     #endif
+
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     server->onNewConnection(this->_server_onNewClientConnectionFn);
+     server->onClosed(this->_server_clientOnSocketClosedFn);
+     #endif
+     server->onReceive(this->_server_clientOnDataArrivalFn);
+     server->onReceiveView(this->_server_clientOnDataViewFn);
+     server->onSent(this->_server_clientOnDataSentFn);
+     server->onError(this->_server_clientOnSocketErrorFn);
+     server->onPoll(this->_server_clientOnPollFn);
+     server->onBufferReleased(this->_server_clientOnBufferReleasedFn);
+     server->onWritable(this->_server_clientOnWritableFn);
+     server->onMessageSent(this->_server_clientOnMessageSentFn);
+     server->onClientJoined(this->_server_onClientJoinedFn);
+     server->onClientLeft(this->_server_onClientLeftFn);
+     this->_applyReceiveMode(server);
+
+     this->_servers[index] = server;
+     return server;
+}
+
+/**
+     * Create a client on the shared client events
+     * @param index Client slot
+     * @return Client
+     */
+HaCClient* HaCEspSockets::_createClient(uint8_t index)
+{
+     #ifdef HAC_ENABLE_STATIC_MEMORY
+     HaCClient *client = &this->_clientStorage[index];
+     #else
+     HaCClient *client = new HaCClient(); 
+     #endif
+
+     client->setCallbacks(&this->_clientCallbacks);
+     this->_applyReceiveMode(client);
+     client->setAutoReconnect(this->_clientAutoReconnect, this->_clientReconnectMinMs, this->_clientReconnectMaxMs);
+     client->setConnectTimeout(this->_clientConnectTimeoutMs);
+
+     this->_clients[index] = client;
+     return client;
+}
+
+/**
+     * Apply the receive mode to the servers and the clients
+     */
+void HaCEspSockets::_applyReceiveMode()
+{
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_SERVERS; i++)
+     {
+          if(this->_servers[i])
+               this->_applyReceiveMode(this->_servers[i]);
+     }
+
+     for(uint8_t i = 0; i < HAC_SOCKETS_MAX_CLIENTS; i++)
+     {
+          if(this->_clients[i])
+               this->_applyReceiveMode(this->_clients[i]);
+     }
+}
+
+/**
+     * Apply the receive mode to a server
+     * @param server Server
+     */
+void HaCEspSockets::_applyReceiveMode(HaCServer *server)
+{
+     if(this->_receiveMode == HAC_RX_MODE_DELIMITED)
+          server->setLineFraming(this->_frameDelimiter, this->_maxFrameLength);
+     else if(this->_receiveMode == HAC_RX_MODE_LENGTH_PREFIXED)
+          server->setLengthPrefixFraming(this->_lengthPrefix, this->_maxFrameLength);
+     else
+          server->setReceiveMode(this->_receiveMode);
+}
+
+/**
+     * Apply the receive mode to a client
+     * @param client Client
+     */
+void HaCEspSockets::_applyReceiveMode(HaCClientInfo *client)
+{
+     if(this->_receiveMode == HAC_RX_MODE_DELIMITED)
+          client->setLineFraming(this->_frameDelimiter, this->_maxFrameLength);
+     else if(this->_receiveMode == HAC_RX_MODE_LENGTH_PREFIXED)
+          client->setLengthPrefixFraming(this->_lengthPrefix, this->_maxFrameLength);
+     else
+          client->setReceiveMode(this->_receiveMode);
+}
+
 /* #endregion */
 
 /* #endregion */
@@ -0,0 +1,387 @@
+/**
+ *
+ * @file HaCFramer-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/* #region SELF_HEADER */
+#include "HaCFramer.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Constructor
+     */
+HaCFramer::HaCFramer() 
+{
+}
+
+/**
+     * Destructor
+     */
+HaCFramer::~HaCFramer() 
+{
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     if(this->_buffer)
+          delete[] this->_buffer;
+     #endif
+}
+
+/**
+     * Setup delimiter framing
+     * @param delimiter Frame delimiter, up to HAC_FRAMER_MAX_DELIMITER_LEN characters
+     * @param maxLength Maximum frame length excluding the delimiter
+     * @return True if the framer is ready
+     */
+bool HaCFramer::setDelimiter(const char *delimiter, uint16_t maxLength)
+{
+     size_t delimiterLen = delimiter ? strlen(delimiter) : 0;
+     if(delimiterLen == 0 || delimiterLen > HAC_FRAMER_MAX_DELIMITER_LEN)
+     {
+          DBG_CB_HSOC("[HACFRAMER] Invalid delimiter!");
+          return false;
+     }
+
+     //Room for the delimiter itself and make sure a dropped frame tail can still be matched
+     if(maxLength < 2 * HAC_FRAMER_MAX_DELIMITER_LEN)
+          maxLength = 2 * HAC_FRAMER_MAX_DELIMITER_LEN;
+
+     if(!this->_allocate(maxLength + delimiterLen))
+          return false;
+
+     memcpy(this->_delimiter, delimiter, delimiterLen + 1);
+     this->_delimiterLen = (uint8_t)delimiterLen;
+     this->_maxLength = maxLength;
+     this->_prefix = HAC_LEN_PREFIX_NONE;
+     this->reset();
+
+     return true;
+}
+
+/**
+     * Setup length prefixed framing
+     * @param prefix Length header type
+     * @param maxLength Maximum frame length excluding the header, longer frames are skipped
+     * @return True if the framer is ready
+     */
+bool HaCFramer::setLengthPrefix(HaCLengthPrefix prefix, uint16_t maxLength)
+{
+     if(prefix == HAC_LEN_PREFIX_NONE || !this->_allocate(maxLength))
+          return false;
+
+     this->_prefix = prefix;
+     this->_delimiterLen = 0;
+     this->_maxLength = maxLength;
+     this->reset();
+
+     return true;
+}
+
+/**
+     * Check if the framer has been setup
+     * @return True if the framer is ready
+     */
+bool HaCFramer::isConfigured() const
+{
+     return this->isDelimited() || this->isLengthPrefixed();
+}
+
+/**
+     * Check if the framer splits on a delimiter
+     * @return True if delimiter framing is setup
+     */
+bool HaCFramer::isDelimited() const
+{
+     return this->_buffer != nullptr && this->_delimiterLen > 0;
+}
+
+/**
+     * Check if the framer reads a length header
+     * @return True if length prefixed framing is setup
+     */
+bool HaCFramer::isLengthPrefixed() const
+{
+     return this->_buffer != nullptr && this->_prefix != HAC_LEN_PREFIX_NONE;
+}
+
+/**
+     * Drop any partial frame
+     */
+void HaCFramer::reset()
+{
+     this->_fill = 0;
+     this->_discarding = false;
+     this->_headerLen = 0;
+     this->_headerDone = false;
+     this->_frameLen = 0;
+     this->_skip = 0;
+}
+
+/**
+     * Feed received bytes to the framer
+     * @param data Received bytes
+     * @param len Number of received bytes
+     * @param fn Called once for every complete frame, the rest is dropped once it returns false
+     * @param ctx Context pointer passed back to fn
+     * @return False if the stream is malformed and can't be framed anymore
+     */
+bool HaCFramer::feed(const uint8_t *data, uint16_t len, HaCFrameFn fn, void *ctx)
+{
+     if(!len)
+          return true;
+
+     if(this->isLengthPrefixed())
+          return this->_feedLengthPrefixed(data, len, fn, ctx);
+
+     if(this->isDelimited())
+          this->_feedDelimited(data, len, fn, ctx);
+
+     return true;
+}
+
+/**
+     * Number of bytes of the partial frame
+     * @return Pending byte count
+     */
+uint16_t HaCFramer::pending() const
+{
+     return this->_fill;
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Allocate the frame buffer, reused if it is already big enough.
+     * With HAC_ENABLE_STATIC_MEMORY the inline storage is used and the capacity is 
+     * limited to HAC_FRAMER_DEF_MAX_LENGTH plus the delimiter.
+     * @param capacity Frame buffer capacity excluding the NUL terminator
+     * @return True if the buffer is available
+     */
+bool HaCFramer::_allocate(uint16_t capacity)
+{
+     #ifdef HAC_ENABLE_STATIC_MEMORY
+     if(capacity >= sizeof(this->_storage))
+          return false;
+
+     this->_buffer = this->_storage;
+     this->_capacity = sizeof(this->_storage) - 1;
+     return true;
+     #else
+     if(this->_buffer && this->_capacity >= capacity)
+          return true;
+
+     if(this->_buffer)
+          delete[] this->_buffer;
+
+     this->_buffer = new uint8_t[capacity + 1];
+     this->_capacity = this->_buffer ? capacity : 0;
+
+     return this->_buffer != nullptr;
+     #endif
+}
+
+/**
+     * Append bytes to the current frame
+     * @param data Bytes to append
+     * @param len Number of bytes
+     */
+void HaCFramer::_append(const uint8_t *data, uint16_t len)
+{
+     if(this->_fill + len <= this->_maxLength + this->_delimiterLen)
+     {
+          memcpy(this->_buffer + this->_fill, data, len);
+          this->_fill += len;
+          return;
+     }
+
+     //Frame is longer than the max length, drop it up to the next delimiter.
+     //Only the last delimiterLen bytes are kept so that a split delimiter is still found.
+     if(!this->_discarding)
+     {
+          DBG_CB_HSOC("[HACFRAMER] Frame too long, dropped..");
+     }
+     this->_discarding = true;
+
+     uint16_t keep = this->_delimiterLen;
+     if(len >= keep)
+     {
+          memcpy(this->_buffer, data + len - keep, keep);
+     }
+     else
+     {
+          memmove(this->_buffer, this->_buffer + this->_fill - (keep - len), keep - len);
+          memcpy(this->_buffer + keep - len, data, len);
+     }
+     this->_fill = keep;
+}
+
+/**
+     * Split the bytes on the delimiter
+     * @param data Received bytes
+     * @param len Number of received bytes
+     * @param fn Called once for every complete frame
+     * @param ctx Context pointer passed back to fn
+     */
+void HaCFramer::_feedDelimited(const uint8_t *data, uint16_t len, HaCFrameFn fn, void *ctx)
+{
+     const uint8_t last = (uint8_t)this->_delimiter[this->_delimiterLen - 1];
+
+     while(len)
+     {
+          //Only the last delimiter byte is scanned, the rest is compared on the frame tail
+          const uint8_t *hit = (const uint8_t*)memchr(data, last, len);
+          uint16_t n = hit ? (uint16_t)(hit - data) + 1 : len;
+
+          this->_append(data, n);
+          data += n;
+          len -= n;
+
+          if(!hit || this->_fill < this->_delimiterLen)
+               continue;
+
+          uint16_t frameLen = this->_fill - this->_delimiterLen;
+          if(memcmp(this->_buffer + frameLen, this->_delimiter, this->_delimiterLen) != 0)
+               continue;
+
+          bool more = true;
+          if(!this->_discarding)
+          {
+               this->_buffer[frameLen] = '\0';
+               more = fn(ctx, this->_buffer, frameLen);
+          }
+          this->reset();
+          if(!more)
+               return;
+     }
+}
+
+/**
+     * Read the length header then the frame body, the body is never scanned
+     * @param data Received bytes
+     * @param len Number of received bytes
+     * @param fn Called once for every complete frame
+     * @param ctx Context pointer passed back to fn
+     * @return False if the length header is malformed
+     */
+bool HaCFramer::_feedLengthPrefixed(const uint8_t *data, uint16_t len, HaCFrameFn fn, void *ctx)
+{
+     while(len)
+     {
+          //Remaining bytes of a frame that is longer than the max length
+          if(this->_skip)
+          {
+               uint16_t n = this->_skip < len ? (uint16_t)this->_skip : len;
+               this->_skip -= n;
+               data += n;
+               len -= n;
+               continue;
+          }
+
+          if(!this->_headerDone)
+          {
+               uint8_t b = *data++;
+               len--;
+
+               if(this->_prefix == HAC_LEN_PREFIX_VARINT)
+               {
+                    this->_frameLen |= (uint32_t)(b & 0x7F) << (7 * this->_headerLen);
+                    this->_headerLen++;
+                    this->_headerDone = !(b & 0x80);
+                    if(!this->_headerDone && this->_headerLen >= 5)
+                    {
+                         DBG_CB_HSOC("[HACFRAMER] Malformed length header!");
+                         this->reset();
+                         return false;
+                    }
+               }
+               else
+               {
+                    this->_frameLen = (this->_frameLen << 8) | b;
+                    this->_headerLen++;
+                    this->_headerDone = this->_headerLen == (this->_prefix == HAC_LEN_PREFIX_U16 ? 2 : 4);
+               }
+
+               if(!this->_headerDone)
+                    continue;
+
+               if(this->_frameLen > this->_maxLength)
+               {
+                    DBG_CB_HSOC("[HACFRAMER] Frame too long, skipped..");
+                    uint32_t skip = this->_frameLen;
+                    this->reset();
+                    this->_skip = skip;
+               }
+               else if(this->_frameLen == 0)
+               {
+                    this->_buffer[0] = '\0';
+                    bool more = fn(ctx, this->_buffer, 0);
+                    this->reset();
+                    if(!more)
+                         return true;
+               }
+               continue;
+          }
+
+          //Whole frame on this segment, pass it without copying
+          if(this->_fill == 0 && len >= this->_frameLen)
+          {
+               uint16_t frameLen = (uint16_t)this->_frameLen;
+               this->reset();
+               if(!fn(ctx, data, frameLen))
+                    return true;
+               data += frameLen;
+               len -= frameLen;
+               continue;
+          }
+
+          uint16_t n = (uint16_t)(this->_frameLen - this->_fill);
+          if(n > len)
+               n = len;
+
+          memcpy(this->_buffer + this->_fill, data, n);
+          this->_fill += n;
+          data += n;
+          len -= n;
+
+          if(this->_fill == this->_frameLen)
+          {
+               this->_buffer[this->_fill] = '\0';
+               bool more = fn(ctx, this->_buffer, this->_fill);
+               this->reset();
+               if(!more)
+                    return true;
+          }
+     }
+
+     return true;
+}
+
+/* #endregion */
+
+/* #endregion */
@@ -0,0 +1,127 @@
+/**
+ *
+ * @file HaCFramer.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef __HAC_FRAMER_H_
+#define __HAC_FRAMER_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCEspSockets.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifndef HAC_FRAMER_DEF_MAX_LENGTH
+#define HAC_FRAMER_DEF_MAX_LENGTH   256
+#endif
+
+#define HAC_FRAMER_DEF_DELIMITER        "\n"
+#define HAC_FRAMER_MAX_DELIMITER_LEN    4
+
+/**
+     * Length header of the length prefixed frames
+     * HAC_LEN_PREFIX_VARINT : Base 128 varint(protobuf style), up to 5 bytes
+     * HAC_LEN_PREFIX_U16 : 16 bit big endian
+     * HAC_LEN_PREFIX_U32 : 32 bit big endian
+     */
+enum HaCLengthPrefix : uint8_t
+{
+    HAC_LEN_PREFIX_NONE = 0,
+    HAC_LEN_PREFIX_VARINT,
+    HAC_LEN_PREFIX_U16,
+    HAC_LEN_PREFIX_U32
+};
+
+/**
+     * Called for every complete frame
+     * @return False to stop feeding the rest of the data(e.g. the connection was closed)
+     */
+typedef bool (*HaCFrameFn)(void *ctx, const uint8_t *frame, uint16_t len);
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Incremental stream framer.
+     * Bytes are fed segment by segment, partial frames are kept between calls and
+     * every complete frame is emitted once.
+     * Delimited frames are NUL terminated and without their delimiter.
+     * Length prefixed frames are emitted without their header, a frame that fits on a
+     * single segment is passed straight from the segment and is not NUL terminated.
+     */
+class HaCFramer
+{
+    public:
+        HaCFramer();
+        ~HaCFramer();
+        HaCFramer(const HaCFramer&) = delete;
+        HaCFramer& operator=(const HaCFramer&) = delete;
+
+        bool setDelimiter(const char *delimiter, uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
+        bool setLengthPrefix(HaCLengthPrefix prefix, uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
+        bool isConfigured() const;
+        bool isDelimited() const;
+        bool isLengthPrefixed() const;
+        void reset();
+        bool feed(const uint8_t *data, uint16_t len, HaCFrameFn fn, void *ctx);
+        uint16_t pending() const;
+
+    private:
+        uint8_t *_buffer = nullptr;
+        #ifdef HAC_ENABLE_STATIC_MEMORY
+        uint8_t _storage[HAC_FRAMER_DEF_MAX_LENGTH + HAC_FRAMER_MAX_DELIMITER_LEN + 1];
+        #endif
+        uint16_t _capacity = 0;
+        uint16_t _maxLength = 0;
+        uint16_t _fill = 0;
+        bool _discarding = false;
+        char _delimiter[HAC_FRAMER_MAX_DELIMITER_LEN + 1] = { 0 };
+        uint8_t _delimiterLen = 0;
+        HaCLengthPrefix _prefix = HAC_LEN_PREFIX_NONE;
+        uint8_t _headerLen = 0;
+        bool _headerDone = false;
+        uint32_t _frameLen = 0;
+        uint32_t _skip = 0;
+
+        bool _allocate(uint16_t capacity);
+        void _append(const uint8_t *data, uint16_t len);
+        void _feedDelimited(const uint8_t *data, uint16_t len, HaCFrameFn fn, void *ctx);
+        bool _feedLengthPrefixed(const uint8_t *data, uint16_t len, HaCFrameFn fn, void *ctx);
+};
+/* #endregion */
+
+#include "HaCFramer-impl.h"
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ *
+ * @file HaCPbufView.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef __HAC_PBUFVIEW_H_
+#define __HAC_PBUFVIEW_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+#include <lwip/tcp.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Read-only view over a received pbuf chain. 
+     * The view never copies nor allocates, it is only valid during the receive callback.
+     */
+class HaCPbufView
+{
+    public:
+        /**
+             * One pbuf segment of the chain
+             */
+        struct Segment
+        {
+            const uint8_t *data;
+            uint16_t length;
+        };
+
+        /**
+             * Forward iterator over the pbuf segments
+             */
+        class Iterator
+        {
+            public:
+                Iterator(const pbuf *p) : _p(p) {}
+                Segment operator*() const { return { (const uint8_t*)this->_p->payload, this->_p->len }; }
+                Iterator& operator++() { this->_p = this->_p->next; return *this; }
+                bool operator!=(const Iterator &other) const { return this->_p != other._p; }
+            private:
+                const pbuf *_p;
+        };
+
+        HaCPbufView(const pbuf *p);
+
+        Iterator begin() const { return Iterator(this->_head); }
+        Iterator end() const { return Iterator(nullptr); }
+
+        uint16_t totalLength() const;
+        uint8_t segmentCount() const;
+        int16_t byteAt(uint16_t index) const;
+        uint16_t copyTo(void *dst, uint16_t len, uint16_t offset = 0) const;
+
+    private:
+        const pbuf *_head = nullptr;
+};
+/* #endregion */
+
+#include "HaCPbufView-impl.h"
+
+#endif
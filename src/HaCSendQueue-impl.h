@@ -0,0 +1,538 @@
+/**
+ *
+ * @file HaCSendQueue-impl.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ *
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/* #region SELF_HEADER */
+#include "HaCSendQueue.h"
+/* #endregion */
+
+
+/* #region CLASS_DEFINITION */
+
+/* #region Public */
+
+/**
+     * Constructor
+     */
+HaCSendQueue::HaCSendQueue() 
+{
+}
+
+/**
+     * Destructor
+     */
+HaCSendQueue::~HaCSendQueue() 
+{
+     #ifndef HAC_ENABLE_STATIC_MEMORY
+     if(this->_ring)
+          delete[] this->_ring;
+     #endif
+}
+
+/**
+     * Queue data to be sent, the data is either fully accepted or not at all
+     * @param pcb Connection socket
+     * @param data Data to be sent
+     * @param len Data length
+     * @param copy False to write straight from data, it must stay valid until acknowledged
+     * @param tagged False for internal data(e.g. the watchdog ping) that gets no message token
+     * @return ERR_OK if accepted, ERR_MEM if the queue is full
+     */
+err_t HaCSendQueue::push(tcp_pcb *pcb, const uint8_t *data, uint16_t len, bool copy, bool tagged)
+{
+     HaCSendSegment segment = { data, len };
+     return this->push(pcb, &segment, 1, copy, tagged);
+}
+
+/**
+     * Queue several buffers to be sent back to back, TCP_WRITE_FLAG_MORE is set 
+     * between the buffers so they are packed on the same segments.
+     * @param pcb Connection socket
+     * @param segments Buffers to be sent
+     * @param count Number of buffers
+     * @param copy False to write straight from the buffers, they must stay valid until acknowledged
+     * @param tagged False for internal data that gets no message token
+     * @return ERR_OK if accepted, ERR_MEM if the queue is full, the lwIP error if the connection is broken, 
+     * ERR_ABRT if lwIP took a part of the message and the rest doesn't fit on the ring, the connection 
+     * has to be dropped then
+     */
+err_t HaCSendQueue::push(tcp_pcb *pcb, const HaCSendSegment *segments, uint8_t count, bool copy, bool tagged)
+{
+     this->_lastToken = HAC_MESSAGE_TOKEN_INVALID;
+     if(HAC_SOCCLIENT_TX_QUEUE_DEPTH - this->_count < count)
+          return ERR_MEM;
+
+     uint32_t total = 0;
+     uint8_t lastIndex = 0;
+     for(uint8_t i = 0; i < count; i++)
+     {
+          total += segments[i].len;
+          if(segments[i].len)
+               lastIndex = i;
+     }
+     if(!total)
+          return ERR_OK;
+
+     //Skip the invalid token when the counter wraps
+     if(tagged && ++this->_nextToken == HAC_MESSAGE_TOKEN_INVALID)
+          this->_nextToken++;
+     uint32_t now = millis();
+
+     //Nothing is waiting to be written, write what the send buffer allows right away
+     uint32_t budget = 0;
+     if(pcb && this->_writeIndex == this->_count)
+          budget = tcp_sndbuf(pcb) < total ? tcp_sndbuf(pcb) : total;
+
+     //What the send buffer can't take now waits on the ring
+     if(copy && (total - budget > 0xFFFF || !this->_ringReserve(total - budget)))
+          return ERR_MEM;
+
+     bool committed = false;
+     uint32_t left = total;
+
+     for(uint8_t i = 0; i < count; i++)
+     {
+          const uint8_t *data = (const uint8_t*)segments[i].data;
+          uint16_t len = segments[i].len;
+          if(!len)
+               continue;
+
+          uint16_t written = 0;
+          if(budget)
+          {
+               written = budget < len ? budget : len;
+               bool more = written < len || i + 1 < count || this->_corked;
+               err_t err = tcp_write(pcb, data, written, 
+                              (copy ? TCP_WRITE_FLAG_COPY : 0) | (more ? TCP_WRITE_FLAG_MORE : 0));
+               if(err != ERR_OK)
+               {
+                    //Nothing is taken yet, the whole message is either queued or refused
+                    if(!committed && (err != ERR_MEM || (copy && (total > 0xFFFF || !this->_ringReserve(total)))))
+                         return err;
+
+                    //lwIP holds the start of the message, a refused write can't be undone
+                    if(committed && copy && (left > 0xFFFF || !this->_ringReserve(left)))
+                    {
+                         //The message ends short, the stream can't be recovered
+                         HaCSendEntry &prev = this->_at(this->_count - 1);
+                         prev.last = true;
+                         return ERR_ABRT;
+                    }
+
+                    //The rest is written later on, flush reports a broken connection
+                    written = 0;
+                    budget = 0;
+               }
+               committed = committed || written;
+               budget -= written;
+          }
+
+          //Room is reserved above
+          if(copy)
+               this->_ringPush(data + written, len - written);
+
+          HaCSendEntry &e = this->_at(this->_count);
+          e.data = copy ? nullptr : data;
+          e.shared = nullptr;
+          e.len = len;
+          e.written = written;
+          e.acked = 0;
+          e.last = i == lastIndex;
+          e.token = e.last && tagged ? this->_nextToken : HAC_MESSAGE_TOKEN_INVALID;
+          e.queuedMs = now;
+
+          this->_count++;
+          if(e.last)
+               this->_lastToken = e.token;
+          if(written == len && this->_writeIndex + 1 == this->_count)
+               this->_writeIndex++;
+          this->_pendingBytes += len;
+          left -= len;
+          if(!copy)
+               this->_referenceCount++;
+     }
+
+     return ERR_OK;
+}
+
+/**
+     * Queue a shared buffer, the queue holds a reference until the data is acknowledged
+     * @param pcb Connection socket
+     * @param shared Shared buffer
+     * @return ERR_OK if accepted, ERR_MEM if the queue is full
+     */
+err_t HaCSendQueue::push(tcp_pcb *pcb, HaCSharedBuffer *shared)
+{
+     if(!shared || !shared->length())
+          return ERR_OK;
+
+     err_t err = this->push(pcb, shared->data(), shared->length(), false);
+     if(err != ERR_OK)
+          return err;
+
+     shared->retain();
+     this->_at(this->_count - 1).shared = shared;
+
+     return ERR_OK;
+}
+
+/**
+     * Write the queued data that fits on the send buffer
+     * @param pcb Connection socket
+     * @return Socket error state
+     */
+err_t HaCSendQueue::flush(tcp_pcb *pcb)
+{
+     if(!pcb)
+          return ERR_CONN;
+
+     while(this->_writeIndex < this->_count)
+     {
+          uint16_t room = tcp_sndbuf(pcb);
+          if(!room)
+               break;
+
+          HaCSendEntry &e = this->_at(this->_writeIndex);
+
+          //Unwritten bytes of the copied messages are on the ring in the same order
+          uint16_t n = e.len - e.written;
+          if(!e.data)
+          {
+               uint16_t contiguous = HAC_SOCCLIENT_TX_BUFFER_SIZE - this->_ringHead;
+               if(n > contiguous)
+                    n = contiguous;
+          }
+          if(n > room)
+               n = room;
+
+          bool more = n < e.len - e.written || this->_writeIndex + 1 < this->_count || this->_corked;
+          const uint8_t *src = e.data ? e.data + e.written : this->_ring + this->_ringHead;
+          err_t err = tcp_write(pcb, src, n, 
+                              (e.data ? 0 : TCP_WRITE_FLAG_COPY) | (more ? TCP_WRITE_FLAG_MORE : 0));
+          if(err == ERR_MEM)
+               break;//lwIP is out of segments, resume on the next acknowledge
+          if(err != ERR_OK)
+               return err;
+
+          if(!e.data)
+               this->_ringPop(n);
+          e.written += n;
+          if(e.written == e.len)
+               this->_writeIndex++;
+     }
+
+     return ERR_OK;
+}
+
+/**
+     * Release the acknowledged messages
+     * @param len Number of bytes acknowledged by the remote end
+     * @param fn Called for every message that is fully acknowledged
+     * @param ctx Context pointer passed back to fn
+     */
+void HaCSendQueue::acked(uint16_t len, HaCSendDoneFn fn, void *ctx)
+{
+     //Runs on with nothing left to count, a message cut by truncate may be complete already
+     while(this->_count)
+     {
+          HaCSendEntry &e = this->_at(0);
+          uint16_t n = e.written - e.acked;
+          if(n > len)
+               n = len;
+
+          e.acked += n;
+          len -= n;
+          this->_pendingBytes -= n;
+
+          if(e.acked < e.len)
+               break;
+
+          //The slot can be reused from fn, keep a copy
+          HaCSendEntry done = e;
+          this->_head = (this->_head + 1) % HAC_SOCCLIENT_TX_QUEUE_DEPTH;
+          this->_count--;
+          this->_writeIndex--;
+
+          this->_release(done, fn, ctx);
+     }
+}
+
+/**
+     * Drop everything on the queue
+     * @param fn Called for every message that is dropped, it must not queue new data
+     * @param ctx Context pointer passed back to fn
+     */
+void HaCSendQueue::clear(HaCSendDoneFn fn, void *ctx)
+{
+     for(uint8_t i = 0; i < this->_count; i++)
+          this->_release(this->_at(i), fn, ctx);
+
+     this->_head = 0;
+     this->_count = 0;
+     this->_writeIndex = 0;
+     this->_pendingBytes = 0;
+     this->_referenceCount = 0;
+     this->_ringHead = 0;
+     this->_ringCount = 0;
+}
+
+/**
+     * Drop the oldest messages no byte of which has been written to the socket yet.
+     * Messages lwIP already holds a part of are kept, the stream would be corrupted otherwise.
+     * @param len Number of bytes to free
+     * @param fn Called for every buffer that is dropped, it must not queue new data
+     * @param ctx Context pointer passed back to fn
+     * @return Number of bytes dropped
+     */
+uint32_t HaCSendQueue::dropUnwritten(uint32_t len, HaCSendDoneFn fn, void *ctx)
+{
+     uint32_t dropped = 0;
+     while(dropped < len && this->_writeIndex < this->_count)
+     {
+          //Only a message starting right at the write position is untouched
+          if(this->_at(this->_writeIndex).written || 
+             (this->_writeIndex && !this->_at(this->_writeIndex - 1).last))
+               break;
+
+          uint8_t n = 1;
+          while(this->_writeIndex + n < this->_count && !this->_at(this->_writeIndex + n - 1).last)
+               n++;
+
+          for(uint8_t i = 0; i < n; i++)
+          {
+               //Unwritten bytes of the copied buffers are at the ring head
+               HaCSendEntry done = this->_at(this->_writeIndex + i);
+               if(!done.data)
+                    this->_ringPop(done.len);
+               this->_pendingBytes -= done.len;
+               dropped += done.len;
+               this->_release(done, fn, ctx);
+          }
+
+          for(uint8_t i = this->_writeIndex; i + n < this->_count; i++)
+               this->_at(i) = this->_at(i + n);
+          this->_count -= n;
+     }
+
+     return dropped;
+}
+
+/**
+     * Drop every byte not written to the socket yet, a message lwIP holds a part of 
+     * is cut at what was written. Used once nothing more can be written(e.g. on close).
+     * @param fn Called for every buffer that is dropped, it must not queue new data
+     * @param ctx Context pointer passed back to fn
+     */
+void HaCSendQueue::truncate(HaCSendDoneFn fn, void *ctx)
+{
+     uint8_t keep = this->_writeIndex;
+     if(keep < this->_count && this->_at(keep).written)
+     {
+          //Never completed, it isn't reported as sent
+          HaCSendEntry &e = this->_at(keep);
+          this->_pendingBytes -= e.len - e.written;
+          e.len = e.written;
+          e.token = HAC_MESSAGE_TOKEN_INVALID;
+          keep++;
+     }
+
+     for(uint8_t i = keep; i < this->_count; i++)
+     {
+          HaCSendEntry done = this->_at(i);
+          this->_pendingBytes -= done.len;
+          this->_release(done, fn, ctx);
+     }
+
+     this->_count = keep;
+     this->_writeIndex = keep;
+     //Only unwritten bytes are kept on the ring
+     this->_ringHead = 0;
+     this->_ringCount = 0;
+
+     this->acked(0, fn, ctx);
+}
+
+/**
+     * Check if all the queued data has been acknowledged
+     * @return True if nothing is queued
+     */
+bool HaCSendQueue::isEmpty() const
+{
+     return this->_count == 0;
+}
+
+/**
+     * Check if the queue still holds referenced(no copy) data lwIP may read from
+     * @return True if referenced data is not yet acknowledged
+     */
+bool HaCSendQueue::hasReferences() const
+{
+     return this->_referenceCount > 0;
+}
+
+/**
+     * Number of queued bytes not yet acknowledged
+     * @return Pending byte count
+     */
+uint32_t HaCSendQueue::pendingBytes() const
+{
+     return this->_pendingBytes;
+}
+
+/**
+     * Number of queued bytes not yet written to the socket
+     * @return Unwritten byte count
+     */
+uint16_t HaCSendQueue::unwrittenBytes() const
+{
+     return this->_ringCount;
+}
+
+/**
+     * Token of the message queued by the last successful push
+     * @return Message token, HAC_MESSAGE_TOKEN_INVALID if nothing was queued
+     */
+HaCMessageToken HaCSendQueue::lastToken() const
+{
+     return this->_lastToken;
+}
+
+/**
+     * Keep TCP_WRITE_FLAG_MORE on every write while the caller sends a batch of messages.
+     * It only clears PSH on the segments, lwIP still transmits them as usual.
+     * @param corked True while more data follows
+     */
+void HaCSendQueue::setCorked(bool corked)
+{
+     this->_corked = corked;
+}
+
+/**
+     * Check if TCP_WRITE_FLAG_MORE is kept on every write
+     * @return True while corked
+     */
+bool HaCSendQueue::isCorked() const
+{
+     return this->_corked;
+}
+
+/* #endregion */
+
+/* #region Private */
+
+/**
+     * Queue entry relative to the head
+     * @param index Entry index
+     * @return Queue entry
+     */
+HaCSendEntry& HaCSendQueue::_at(uint8_t index)
+{
+     return this->_entries[(this->_head + index) % HAC_SOCCLIENT_TX_QUEUE_DEPTH];
+}
+
+/**
+     * Release the references held by a done entry
+     * @param entry Acknowledged or dropped entry
+     * @param fn Called for the entry
+     * @param ctx Context pointer passed back to fn
+     */
+void HaCSendQueue::_release(const HaCSendEntry &entry, HaCSendDoneFn fn, void *ctx)
+{
+     if(entry.data)
+          this->_referenceCount--;
+
+     if(fn)
+          fn(ctx, entry);
+
+     if(entry.shared)
+          entry.shared->release();
+}
+
+/**
+     * Make sure the ring buffer has room, it is allocated on the first use
+     * @param len Number of bytes
+     * @return True if there is enough room
+     */
+bool HaCSendQueue::_ringReserve(uint16_t len)
+{
+     if(!len)
+          return true;
+
+     if(HAC_SOCCLIENT_TX_BUFFER_SIZE - this->_ringCount < len)
+          return false;
+
+     if(!this->_ring)
+     {
+          #ifdef HAC_ENABLE_STATIC_MEMORY
+          this->_ring = this->_ringStorage;
+          #else
+          this->_ring = new uint8_t[HAC_SOCCLIENT_TX_BUFFER_SIZE];
+          #endif
+     }
+
+     return this->_ring != nullptr;
+}
+
+/**
+     * Copy bytes to the ring buffer
+     * @param data Bytes to copy
+     * @param len Number of bytes
+     * @return True if there is enough room
+     */
+bool HaCSendQueue::_ringPush(const uint8_t *data, uint16_t len)
+{
+     if(!len)
+          return true;
+
+     if(!this->_ringReserve(len))
+          return false;
+
+     uint16_t tail = (this->_ringHead + this->_ringCount) % HAC_SOCCLIENT_TX_BUFFER_SIZE;
+     uint16_t n = HAC_SOCCLIENT_TX_BUFFER_SIZE - tail;
+     if(n > len)
+          n = len;
+
+     memcpy(this->_ring + tail, data, n);
+     memcpy(this->_ring, data + n, len - n);
+     this->_ringCount += len;
+
+     return true;
+}
+
+/**
+     * Release bytes from the ring buffer
+     * @param len Number of bytes
+     */
+void HaCSendQueue::_ringPop(uint16_t len)
+{
+     this->_ringHead = (this->_ringHead + len) % HAC_SOCCLIENT_TX_BUFFER_SIZE;
+     this->_ringCount -= len;
+     if(!this->_ringCount)
+          this->_ringHead = 0;
+}
+
+/* #endregion */
+
+/* #endregion */
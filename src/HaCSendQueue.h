@@ -0,0 +1,151 @@
+/**
+ *
+ * @file HaCSendQueue.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef __HAC_SENDQUEUE_H_
+#define __HAC_SENDQUEUE_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCEspSockets.h"
+#include "HaCSharedBuffer.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+#include <lwip/tcp.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifndef HAC_SOCCLIENT_TX_QUEUE_DEPTH
+#define HAC_SOCCLIENT_TX_QUEUE_DEPTH    16
+#endif
+
+#ifndef HAC_SOCCLIENT_TX_BUFFER_SIZE
+#define HAC_SOCCLIENT_TX_BUFFER_SIZE    1024
+#endif
+
+/**
+     * Message token, identifies a queued message until it is acknowledged
+     */
+typedef uint32_t HaCMessageToken;
+#define HAC_MESSAGE_TOKEN_INVALID       0
+
+/**
+     * One buffer of a vectored send
+     */
+struct HaCSendSegment
+{
+    const void *data;
+    uint16_t len;
+};
+
+/**
+     * One queued message, kept until all of its bytes are acknowledged
+     */
+struct HaCSendEntry
+{
+    const uint8_t *data;//Referenced buffer, nullptr if the data is copied
+    HaCSharedBuffer *shared;//Shared buffer the data belongs to, released once done
+    uint16_t len;
+    uint16_t written;
+    uint16_t acked;
+    bool last;//Last buffer of a message, a message is only dropped as a whole
+    HaCMessageToken token;//Message token, only set on the last buffer
+    uint32_t queuedMs;//millis() when the message was queued
+};
+
+typedef void (*HaCSendDoneFn)(void *ctx, const HaCSendEntry &entry);
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Per connection outbound queue.
+     * Only what tcp_sndbuf allows is written, the unwritten remainder is copied to a
+     * ring buffer and written later on when the remote end acknowledges the data.
+     * Referenced(no copy) data is written straight from the caller buffer, the buffer
+     * must stay valid until its entry is done.
+     */
+class HaCSendQueue
+{
+    public:
+        HaCSendQueue();
+        ~HaCSendQueue();
+        HaCSendQueue(const HaCSendQueue&) = delete;
+        HaCSendQueue& operator=(const HaCSendQueue&) = delete;
+
+        err_t push(tcp_pcb *pcb, const uint8_t *data, uint16_t len, bool copy = true, bool tagged = true);
+        err_t push(tcp_pcb *pcb, const HaCSendSegment *segments, uint8_t count, bool copy = true, bool tagged = true);
+        err_t push(tcp_pcb *pcb, HaCSharedBuffer *shared);
+        err_t flush(tcp_pcb *pcb);
+        void acked(uint16_t len, HaCSendDoneFn fn = nullptr, void *ctx = nullptr);
+        void clear(HaCSendDoneFn fn = nullptr, void *ctx = nullptr);
+        uint32_t dropUnwritten(uint32_t len, HaCSendDoneFn fn = nullptr, void *ctx = nullptr);
+        void truncate(HaCSendDoneFn fn = nullptr, void *ctx = nullptr);
+
+        bool isEmpty() const;
+        bool hasReferences() const;
+        uint32_t pendingBytes() const;
+        uint16_t unwrittenBytes() const;
+        HaCMessageToken lastToken() const;
+        void setCorked(bool corked);
+        bool isCorked() const;
+
+    private:
+        HaCSendEntry _entries[HAC_SOCCLIENT_TX_QUEUE_DEPTH];
+        uint8_t _head = 0;
+        uint8_t _count = 0;
+        uint8_t _writeIndex = 0;
+        uint32_t _pendingBytes = 0;
+        uint8_t _referenceCount = 0;
+        HaCMessageToken _nextToken = HAC_MESSAGE_TOKEN_INVALID;
+        HaCMessageToken _lastToken = HAC_MESSAGE_TOKEN_INVALID;
+        bool _corked = false;
+
+        uint8_t *_ring = nullptr;
+        #ifdef HAC_ENABLE_STATIC_MEMORY
+        uint8_t _ringStorage[HAC_SOCCLIENT_TX_BUFFER_SIZE];
+        #endif
+        uint16_t _ringHead = 0;
+        uint16_t _ringCount = 0;
+
+        HaCSendEntry& _at(uint8_t index);
+        void _release(const HaCSendEntry &entry, HaCSendDoneFn fn, void *ctx);
+        bool _ringReserve(uint16_t len);
+        bool _ringPush(const uint8_t *data, uint16_t len);
+        void _ringPop(uint16_t len);
+};
+/* #endregion */
+
+#include "HaCSendQueue-impl.h"
+
+#endif
@@ -35,6 +35,10 @@
      */
 HaCServer::HaCServer()
 {
+    this->_clientCallbacks.onClosed = [this](HaCClientInfo * clientInfo)
+        {
+            this->_clientInfo_onClosed(clientInfo);
+        };
 }
 
 /**
@@ -42,8 +46,7 @@ HaCServer::HaCServer()
      */
 HaCServer::~HaCServer()
 {
-    if(this->_clientInfo != nullptr)
-        delete this->_clientInfo;
+    this->stop();
 }
 
 /**
@@ -53,10 +56,178 @@ HaCServer::~HaCServer()
      */
 bool HaCServer::setPingWatchdog(bool enable)
 {    
-     this->_enablePingWatchdog = enable;
-     return this->_enablePingWatchdog;
+     return this->setPingWatchdog(enable ? HAC_WATCHDOG_PING : HAC_WATCHDOG_OFF);
+}
+
+/**
+     * Set the dead peer detection mode of the incoming connections
+     * @param mode HAC_WATCHDOG_OFF, HAC_WATCHDOG_PING or HAC_WATCHDOG_KEEPALIVE
+     * @param idleMs Keepalive only, idle time before the first probe
+     * @param intervalMs Keepalive only, time between probes
+     * @param count Keepalive only, unanswered probes before the connection is dropped
+     * @return Return watchdog enable state
+     */
+bool HaCServer::setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs, uint32_t intervalMs, uint8_t count)
+{    
+     this->_watchdogMode = mode;
+     this->_keepAliveIdle = idleMs;
+     this->_keepAliveInterval = intervalMs;
+     this->_keepAliveCount = count;
+
+     return this->_watchdogMode != HAC_WATCHDOG_OFF;
+}
+
+/**
+     * Close incoming connections that stay idle for a while
+     * @param timeoutMs Idle time in ms, 0 to disable
+     */
+void HaCServer::setIdleTimeout(uint32_t timeoutMs)
+{    
+     this->_idleTimeoutMs = timeoutMs;
+}
+
+/**
+     * Let the application open the receive window of the incoming connections(See HaCClientInfo::consume)
+     * @param enable True to open the window with consume, false to open it on receive(Default)
+     */
+void HaCServer::setManualReceiveWindow(bool enable)
+{    
+     this->_manualReceiveWindow = enable;
+}
+
+/**
+     * Limit the unacknowledged data of every incoming connection(See HaCClientInfo::setSendWatermarks)
+     * @param high Unacknowledged bytes before a connection is a slow consumer, 0 to disable
+     * @param low Unacknowledged bytes before onWritable is raised, 0 for half of high
+     */
+void HaCServer::setSendWatermarks(uint32_t high, uint32_t low)
+{    
+     this->_txHighWatermark = high;
+     this->_txLowWatermark = low;
+}
+
+/**
+     * Set what happens to new data for a connection at its send high watermark, 
+     * a stalled client then can't hold up the broadcasts to the others
+     * @param policy HAC_SLOW_CONSUMER_DROP_NEWEST, HAC_SLOW_CONSUMER_DROP_OLDEST or HAC_SLOW_CONSUMER_DISCONNECT
+     */
+void HaCServer::setSlowConsumerPolicy(HaCSlowConsumerPolicy policy)
+{    
+     this->_slowConsumerPolicy = policy;
+}
+
+/**
+     * Turn the Nagle algorithm off on the incoming connections(See HaCClientInfo::setNoDelay)
+     * @param enable True to disable Nagle
+     */
+void HaCServer::setNoDelay(bool enable)
+{    
+     this->_noDelay = enable;
+}
+
+/**
+     * Take the connection slots from another pool than the library wide one, 
+     * e.g. to keep a server from running out of slots because of another
+     * @param pool Connection pool, nullptr for the library wide pool(Default)
+     * @return False if the server is running, the pool can't be changed then
+     */
+bool HaCServer::setPool(HaCClientPool *pool)
+{    
+     if(this->_listenerSoc)
+          return false;
+
+     this->_pool = pool ? pool : &HaCClientPool::shared();
+
+     return true;
+}
+
+/**
+     * Limit the number of connections at runtime, connections already open 
+     * above a lowered limit are kept
+     * @param maxClients Maximum connections, limited to HAC_SERVER_MAX_SOCKET_CLIENTS, 0 for the full pool
+     */
+void HaCServer::setMaxClients(uint8_t maxClients)
+{    
+     if(!maxClients || maxClients > this->_pool->capacity())
+          maxClients = this->_pool->capacity();
+
+     this->_maxClients = maxClients;
+}
+
+/**
+     * Maximum number of connections
+     * @return Connection limit
+     */
+uint8_t HaCServer::getMaxClients() const
+{    
+     return this->_maxClients;
+}
+
+/**
+     * Get the listening port
+     * @return Port given to setup
+     */
+uint16_t HaCServer::getPort() const
+{    
+     return this->_port;
 }
 
+/**
+     * Set the listen backlog, applied on the next start
+     * @param backlog Connections lwIP holds pending before accepting them, 0 for HAC_SERVER_MAX_SOCKET_CLIENTS
+     */
+void HaCServer::setBacklog(uint8_t backlog)
+{    
+     this->_backlog = backlog ? backlog : HAC_SERVER_MAX_SOCKET_CLIENTS;
+}
+
+/**
+     * Set what happens to a connection arriving while the server is full, 
+     * a busy frame lets the clients back off instead of reconnecting in a tight loop
+     * @param policy HAC_ADMISSION_REFUSE or HAC_ADMISSION_BUSY_FRAME
+     * @param retryAfterMs Retry delay announced by the busy frame
+     */
+void HaCServer::setAdmissionPolicy(HaCAdmissionPolicy policy, uint32_t retryAfterMs)
+{    
+     this->_admissionPolicy = policy;
+     this->_retryAfterMs = retryAfterMs;
+}
+
+/**
+     * Set the receive data mode of the incoming connections
+     * @param mode HAC_RX_MODE_TEXT, HAC_RX_MODE_BINARY, HAC_RX_MODE_DELIMITED or HAC_RX_MODE_LENGTH_PREFIXED
+     */
+void HaCServer::setReceiveMode(HaCReceiveMode mode)
+{    
+     this->_receiveMode = mode;
+}
+
+/**
+     * Enable delimiter framing on the incoming connections
+     * @param delimiter Line delimiter, up to HAC_FRAMER_MAX_DELIMITER_LEN characters
+     * @param maxLength Maximum line length, longer lines are dropped
+     */
+void HaCServer::setLineFraming(const char *delimiter, uint16_t maxLength)
+{    
+     if(!delimiter || strlen(delimiter) > HAC_FRAMER_MAX_DELIMITER_LEN)
+          return;
+
+     strcpy(this->_frameDelimiter, delimiter);
+     this->_maxFrameLength = maxLength;
+     this->_receiveMode = HAC_RX_MODE_DELIMITED;
+}
+
+/**
+     * Enable length prefixed framing on the incoming connections
+     * @param prefix HAC_LEN_PREFIX_VARINT, HAC_LEN_PREFIX_U16 or HAC_LEN_PREFIX_U32
+     * @param maxLength Maximum frame length, longer frames are skipped
+     */
+void HaCServer::setLengthPrefixFraming(HaCLengthPrefix prefix, uint16_t maxLength)
+{    
+     this->_lengthPrefix = prefix;
+     this->_maxFrameLength = maxLength;
+     this->_receiveMode = HAC_RX_MODE_LENGTH_PREFIXED;
+}
 
 /**
      * Socket Server Setup.
@@ -87,7 +258,7 @@ void HaCServer::start()
         return;
     }
 
-    tcp_pcb *listenSoc = tcp_listen_with_backlog(lsoc, HAC_SERVER_MAX_SOCKET_CLIENTS);
+    tcp_pcb *listenSoc = tcp_listen_with_backlog(lsoc, this->_backlog);
 
     if(!listenSoc)
     {
@@ -115,17 +286,15 @@ void HaCServer::stop()
     tcp_close(this->_listenerSoc);
     this->_listenerSoc = nullptr;
 
-    if(this->_clientInfos.size() >=1)
+    for(uint8_t i = 0; i < this->_pool->capacity(); i++)
     {
-        for(auto p : this->_clientInfos)
-        {
-            if(p != nullptr)
-                delete p;
-        }
-    }
+        if(!this->_pool->isUsedBy(i, this))
+            continue;
 
-    this->_clientInfos.clear();
-    this->_clientInfos = std::vector<HaCClientInfo*>();
+        HaCClientInfo *p = this->_pool->at(i);
+        p->abort();
+        this->_pool->release(p);
+    }
 }
 
 /**
@@ -133,13 +302,89 @@ void HaCServer::stop()
      */
 void HaCServer::broadCastMessage(const char * message)
 {
-    if(this->_clientInfos.size() <= 0 ) return;
+    this->broadCastMessage(message, strlen(message));
+}
+
+/**
+     * Broadcast binary data to all connected clients, the data is copied once 
+     * to a shared buffer released when the last client acknowledges it.
+     * Without a free shared buffer(e.g. the HAC_ENABLE_STATIC_MEMORY pool is used up)
+     * each connection queues its own copy. Data longer than 0xFFFF bytes isn't sent.
+     * @param data data to be sent
+     * @param len data length
+     */
+void HaCServer::broadCastMessage(const void *data, size_t len)
+{
+    if(this->_pool->used(this) <= 0 || len > 0xFFFF) return;
+
+    //Shed the broadcast rather than take the last of the heap
+    if(!HaCMemoryGovernor::instance().canBroadcast())
+    {
+        DBG_CB_HSOC("\n[HACSERVER] Low heap, broadcast dropped");
+        return;
+    }
+
+    HaCSharedBuffer *shared = HaCSharedBuffer::create(data, (uint16_t)len);
+    if(!shared)
+    {
+        DBG_CB_HSOC("\n[HACSERVER] No shared buffer, the message is copied to each connection");
+    }
 
-    for(auto p : this->_clientInfos)
+    for(uint8_t i = 0; i < this->_pool->capacity(); i++)
     {
-        DBG_CB_HSOC2("\n[HACSERVER] Sending message from client connection id = %d", p->getConnectionId());
-        p->sendData(message);
+        if(!this->_pool->isUsedBy(i, this))
+            continue;
+
+        HaCClientInfo *p = this->_pool->at(i);
+        DBG_CB_HSOC2("\n[HACSERVER] Sending message from client connection id = %lu", (unsigned long)p->getConnectionId());
+        if(shared)
+            p->sendShared(shared);
+        else
+            p->send(data, len);
     }
+
+    if(shared)
+        shared->release();
+}
+
+/**
+     * Get a connected client by its connection handle
+     * @param handle Connection handle(See HaCClientInfo::getConnectionId)
+     * @return Client connection or nullptr if it has already been closed
+     */
+HaCClientInfo* HaCServer::getClient(HaCConnectionHandle handle)
+{
+    return this->_pool->find(handle, this);
+}
+
+/**
+     * View of the connected clients
+     * @return Roster over the live connections
+     */
+HaCClientRoster HaCServer::clients()
+{
+    return HaCClientRoster(this->_pool, nullptr, this);
+}
+
+/**
+     * Send data to a client by its connection handle, the size limit of 
+     * HaCClientInfo::send applies
+     * @param handle Connection handle
+     * @param data Data to send
+     * @param len Data length
+     * @param token Optional, receives the message token reported by onMessageSent
+     * @return Send result or ERR_CONN if the handle is stale
+     */
+long HaCServer::send(HaCConnectionHandle handle, const void *data, size_t len, HaCMessageToken *token)
+{
+    if(token)
+        *token = HAC_MESSAGE_TOKEN_INVALID;
+
+    HaCClientInfo *clientInfo = this->_pool->find(handle, this);
+    if(!clientInfo)
+        return ERR_CONN;
+
+    return clientInfo->send(data, len, token);
 }
 
 /**
@@ -148,7 +393,16 @@ void HaCServer::broadCastMessage(const char * message)
      */
 void HaCServer::onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn)
 {
-     this->_onReceiveFn = fn;
+     this->_clientCallbacks.onReceive = fn;
+}
+
+/**
+     * onReceiveView Delegate function.           
+     * @param fn onReceiveView Callback function.
+     */
+void HaCServer::onReceiveView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn)
+{
+     this->_clientCallbacks.onReceiveView = fn;
 }
 
 /**
@@ -157,7 +411,7 @@ void HaCServer::onReceive(std::function<void(HaCClientInfo*, const char*, uint16
      */
 void HaCServer::onSent(std::function<void(uint16_t, HaCClientInfo*)> fn)
 {
-     this->_onSentFn = fn;
+     this->_clientCallbacks.onSent = fn;
 }
 
 /**
@@ -166,7 +420,7 @@ void HaCServer::onSent(std::function<void(uint16_t, HaCClientInfo*)> fn)
      */
 void HaCServer::onError(std::function<void(uint16_t, HaCClientInfo*)> fn)
 {
-     this->_onErrorFn = fn;
+     this->_clientCallbacks.onError = fn;
 }
 
 /**
@@ -175,11 +429,41 @@ void HaCServer::onError(std::function<void(uint16_t, HaCClientInfo*)> fn)
      */
 void HaCServer::onPoll(std::function<void(HaCClientInfo*)> fn)
 {
-     this->_onPollFn = fn;
+     this->_clientCallbacks.onPoll = fn;
+}
+
+/**
+     * onBufferReleased Delegate function.           
+     * @param fn onBufferReleased Callback function.
+     */
+void HaCServer::onBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn)
+{
+     this->_clientCallbacks.onBufferReleased = fn;
+}
+
+/**
+     * onWritable Delegate function.           
+     * @param fn onWritable Callback function.
+     */
+void HaCServer::onWritable(std::function<void(HaCClientInfo*)> fn)
+{
+     this->_clientCallbacks.onWritable = fn;
+}
+
+/**
+     * onMessageSent Delegate function.           
+     * @param fn onMessageSent Callback function.
+     */
+void HaCServer::onMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn)
+{
+     this->_clientCallbacks.onMessageSent = fn;
 }
 
+#ifndef HAC_ENABLE_STATIC_MEMORY
 /**
      * onClosed Delegate function.           
+     * The remaining clients are copied to a vector on every close, not available 
+     * with HAC_ENABLE_STATIC_MEMORY(See onClientLeft).
      * @param fn onClosed Callback function.
      */
 void HaCServer::onClosed(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn)
@@ -189,12 +473,35 @@ void HaCServer::onClosed(std::function<void(HaCClientInfo*, std::vector<HaCClien
 
 /**
      * onNewConnection Delegate function.           
+     * The connected clients are copied to a vector on every accept, not available 
+     * with HAC_ENABLE_STATIC_MEMORY(See onClientJoined).
      * @param fn onNewConnection Callback function.
      */
 void HaCServer::onNewConnection(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn)
 {    
     this->_onNewConnectionFn = fn;
 }
+#endif
+
+/**
+     * onClientJoined Delegate function.
+     * Same as onNewConnection but the connected clients are given as a view, nothing is copied.
+     * @param fn onClientJoined Callback function.
+     */
+void HaCServer::onClientJoined(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn)
+{
+    this->_onClientJoinedFn = fn;
+}
+
+/**
+     * onClientLeft Delegate function.
+     * Same as onClosed but the remaining clients are given as a view, nothing is copied.
+     * @param fn onClientLeft Callback function.
+     */
+void HaCServer::onClientLeft(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn)
+{
+    this->_onClientLeftFn = fn;
+}
 
 /* #endregion */
 
@@ -207,36 +514,38 @@ void HaCServer::onNewConnection(std::function<void(HaCClientInfo*, std::vector<H
      */
 err_t HaCServer::_accept(tcp_pcb* newSoc, err_t err)
 {
-    //Check if the connection is on the limit    
-    if(this->_clientInfos.size() >= HAC_SERVER_MAX_SOCKET_CLIENTS)
+    //lwIP couldn't allocate the new connection, there is nothing to take
+    if(err != ERR_OK || !newSoc)
+        return ERR_VAL;
+
+    //Take a free slot, none left or a low heap means the connection is on the limit
+    HaCClientInfo *clInfo = nullptr;
+    if(this->_pool->used(this) < this->_maxClients && HaCMemoryGovernor::instance().canAccept())
+        clInfo = this->_pool->acquire(this);
+    if(!clInfo)
     {
-        //Refuse the new connection
-        tcp_close(newSoc);
-        newSoc = nullptr;
-        
-        return ERR_ABRT;
+        //Refuse the new connection, lwIP has to be told only if it was aborted
+        return this->_refuse(newSoc) ? ERR_ABRT : ERR_OK;
     } 
 
-    this->_clientInfo = new HaCClientInfo(newSoc,[&](HaCClientInfo * clInfo, tcp_pcb* soc)
-        {
-            tcp_backlog_delayed(soc);
-            tcp_backlog_accepted(soc);
-            clInfo->setPingWatchdog(this->_enablePingWatchdog);
-            clInfo->onReceive(this->_onReceiveFn);
-            clInfo->onSent(this->_onSentFn);
-            clInfo->onError(this->_onErrorFn);
-            clInfo->onPoll(this->_onPollFn);
-
-            clInfo->onClosed(
-                [&](HaCClientInfo * clientInfo)
-                {
-                    this->_clientInfo_onClosed(clientInfo);
-                });
-
-            this->_clientInfo_onAccepted(clInfo);
-        }
-    );
-
+    tcp_backlog_delayed(newSoc);
+    tcp_backlog_accepted(newSoc);
+    clInfo->setupClientSocket(newSoc);
+    clInfo->setPingWatchdog(this->_watchdogMode, this->_keepAliveIdle, this->_keepAliveInterval, this->_keepAliveCount);
+    clInfo->setIdleTimeout(this->_idleTimeoutMs);
+    clInfo->setManualReceiveWindow(this->_manualReceiveWindow);
+    clInfo->setSendWatermarks(this->_txHighWatermark, this->_txLowWatermark);
+    clInfo->setSlowConsumerPolicy(this->_slowConsumerPolicy);
+    clInfo->setNoDelay(this->_noDelay);
+    if(this->_receiveMode == HAC_RX_MODE_DELIMITED)
+        clInfo->setLineFraming(this->_frameDelimiter, this->_maxFrameLength);
+    else if(this->_receiveMode == HAC_RX_MODE_LENGTH_PREFIXED)
+        clInfo->setLengthPrefixFraming(this->_lengthPrefix, this->_maxFrameLength);
+    else
+        clInfo->setReceiveMode(this->_receiveMode);
+    clInfo->setCallbacks(&this->_clientCallbacks);
+
+    this->_clientInfo_onAccepted(clInfo);
 
     return ERR_OK;
 }
@@ -262,14 +571,16 @@ err_t HaCServer::_accept(void *arg, tcp_pcb* newSoc, err_t err)
      */
 void HaCServer::_clientInfo_onAccepted(HaCClientInfo * clientInfo)
 {       
-    clientInfo->setConnectionId(this->_clientInfos.size());
-    DBG_CB_HSOC2("\n[HACSERVER] Client = %d connection has been accepted..\n", clientInfo->getConnectionId());
-    this->_clientInfos.push_back(clientInfo);
+    clientInfo->setConnectionId(this->_pool->handleOf(clientInfo));
+    DBG_CB_HSOC2("\n[HACSERVER] Client = %lu connection has been accepted..\n", (unsigned long)clientInfo->getConnectionId());
 
-    if(this->_onNewConnectionFn)
-        this->_onNewConnectionFn(clientInfo, this->_clientInfos);
+    if(this->_onClientJoinedFn)
+        this->_onClientJoinedFn(clientInfo, HaCClientRoster(this->_pool, nullptr, this));
 
-        
+    #ifndef HAC_ENABLE_STATIC_MEMORY
+    if(this->_onNewConnectionFn)
+        this->_onNewConnectionFn(clientInfo, this->_connectedClients());
+    #endif
 }
 
 
@@ -279,37 +590,73 @@ void HaCServer::_clientInfo_onAccepted(HaCClientInfo * clientInfo)
      */
 void HaCServer::_clientInfo_onClosed(HaCClientInfo * clientInfo)
 {    
-    DBG_CB_HSOC2("\n[HACSERVER] Client with connection id = %d, closed connections..\n", clientInfo->getConnectionId());
+    DBG_CB_HSOC2("\n[HACSERVER] Client with connection id = %lu, closed connections..\n", (unsigned long)clientInfo->getConnectionId());
 
-    std::vector<HaCClientInfo*>::iterator end;
-    
-    //Save to temporary vector
-    std::vector<HaCClientInfo*> tmp = std::vector<HaCClientInfo*>();
-    for(auto p: this->_clientInfos)
+    //Raised CB before giving the slot back, the closing client is no longer listed
+    if(this->_onClientLeftFn)
+        this->_onClientLeftFn(clientInfo, HaCClientRoster(this->_pool, clientInfo, this));
+
+    #ifndef HAC_ENABLE_STATIC_MEMORY
+    if(this->_onClosedFn)
     {
-        if(p->getConnectionId() != clientInfo->getConnectionId())
-            tmp.push_back(p);        
+        std::vector<HaCClientInfo*> clientInfos = this->_connectedClients();
+        for(auto it = clientInfos.begin(); it != clientInfos.end(); ++it)
+        {
+            if(*it == clientInfo)
+            {
+                clientInfos.erase(it);
+                break;
+            }
+        }
+        this->_onClosedFn(clientInfo, clientInfos);
     }
+    #endif
 
-    //Delete old vectors
-    this->_clientInfos.clear();
-    this->_clientInfos = std::vector<HaCClientInfo*>();
+    //Give the slot back to the pool
+    this->_pool->release(clientInfo);
+}
 
-    //Assign tmp vector to newly cleared clientinfos vector
-    for(auto p: tmp)
-        this->_clientInfos.push_back(p);
-    
-    //Delete tmp vector
-    tmp.clear();
-    tmp = std::vector<HaCClientInfo*>();
+#ifndef HAC_ENABLE_STATIC_MEMORY
+/**
+     * List of the connected clients
+     * @return Connected client pointers
+     */
+std::vector<HaCClientInfo*> HaCServer::_connectedClients()
+{
+    std::vector<HaCClientInfo*> clientInfos;
+    for(uint8_t i = 0; i < this->_pool->capacity(); i++)
+    {
+        if(this->_pool->isUsedBy(i, this))
+            clientInfos.push_back(this->_pool->at(i));
+    }
 
-    //Raised CB before deleting the clientinfo pointer
-    if(this->_onClosedFn)
-        this->_onClosedFn(clientInfo, this->_clientInfos);
+    return clientInfos;
+}
+#endif
+
+/**
+     * Turn down a connection while the server is full or low on heap according to the admission policy
+     * @param soc Incoming socket, closed once it returns
+     * @return True if the socket had to be aborted
+     */
+bool HaCServer::_refuse(tcp_pcb *soc)
+{
+    DBG_CB_HSOC("\n[HACSERVER] Server is busy, connection refused..");
+    if(this->_admissionPolicy == HAC_ADMISSION_BUSY_FRAME)
+    {
+        char frame[sizeof(HAC_BUSY_FRAME_PREFIX) + 12];
+        int len = snprintf(frame, sizeof(frame), HAC_BUSY_FRAME_PREFIX "%lu\n", (unsigned long)this->_retryAfterMs);
+
+        //Best effort, the frame goes out ahead of the FIN if the send buffer takes it
+        if(tcp_write(soc, frame, (uint16_t)len, TCP_WRITE_FLAG_COPY) == ERR_OK)
+            tcp_output(soc);
+    }
+
+    if(tcp_close(soc) == ERR_OK)
+        return false;
 
-    //Free clienInfo
-    if(clientInfo != nullptr)
-        delete clientInfo;
+    tcp_abort(soc);
+    return true;
 }
 
 /* #endregion */
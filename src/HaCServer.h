@@ -35,6 +35,8 @@
 
 /* #region INTERNAL_DEPENDENCY */
 #include "HaCClientInfo.h"
+#include "HaCClientPool.h"
+#include "HaCClientRoster.h"
 /* #endregion */
 
 /* #region EXTERNAL_DEPENDENCY */
@@ -45,11 +47,22 @@
 /* #endregion */
 
 /* #region GLOBAL_DECLARATION */
-#ifndef HAC_SERVER_MAX_SOCKET_CLIENTS
-#define HAC_SERVER_MAX_SOCKET_CLIENTS   5
+#define HAC_SERVER_DEF_PORT 5000
+
+#ifndef HAC_SERVER_DEF_RETRY_AFTER_MS
+#define HAC_SERVER_DEF_RETRY_AFTER_MS   2000    //Retry delay announced by the busy frame
 #endif
 
-#define HAC_SERVER_DEF_PORT 5000
+/**
+     * What happens to a connection arriving while the server is full
+     * HAC_ADMISSION_REFUSE : The connection is closed without a word(Default)
+     * HAC_ADMISSION_BUSY_FRAME : A busy frame(HAC_BUSY_FRAME_PREFIX + retry delay in ms + \n) is sent before closing
+     */
+enum HaCAdmissionPolicy : uint8_t
+{
+    HAC_ADMISSION_REFUSE = 0,
+    HAC_ADMISSION_BUSY_FRAME
+};
 /* #endregion */
 
 /* #region CLASS_DECLARATION */
@@ -63,38 +76,92 @@ class HaCServer
         void start();
         void stop();
         void broadCastMessage(const char *message);
+        void broadCastMessage(const void *data, size_t len);
+        void setIdleTimeout(uint32_t timeoutMs);
+        void setManualReceiveWindow(bool enable = true);
+        void setSendWatermarks(uint32_t high, uint32_t low = 0);
+        void setSlowConsumerPolicy(HaCSlowConsumerPolicy policy);
+        void setNoDelay(bool enable = true);
+        bool setPool(HaCClientPool *pool);
+        void setMaxClients(uint8_t maxClients);
+        uint8_t getMaxClients() const;
+        uint16_t getPort() const;
+        void setBacklog(uint8_t backlog);
+        void setAdmissionPolicy(HaCAdmissionPolicy policy, uint32_t retryAfterMs = HAC_SERVER_DEF_RETRY_AFTER_MS);
+        HaCClientInfo* getClient(HaCConnectionHandle handle);
+        long send(HaCConnectionHandle handle, const void *data, size_t len, HaCMessageToken *token = nullptr);
+        HaCClientRoster clients();
         bool setPingWatchdog(bool enable = true);
+        bool setPingWatchdog(HaCWatchdogMode mode, uint32_t idleMs = HAC_KEEPALIVE_DEF_IDLE,
+                             uint32_t intervalMs = HAC_KEEPALIVE_DEF_INTERVAL, 
+                             uint8_t count = HAC_KEEPALIVE_DEF_COUNT);
+        void setReceiveMode(HaCReceiveMode mode);
+        void setLineFraming(const char *delimiter = HAC_FRAMER_DEF_DELIMITER, 
+                            uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
+        void setLengthPrefixFraming(HaCLengthPrefix prefix = HAC_LEN_PREFIX_U16, 
+                                    uint16_t maxLength = HAC_FRAMER_DEF_MAX_LENGTH);
         
         /* #region Event functions(ClientInfo Events) */
         void onReceive(std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> fn);
+        void onReceiveView(std::function<void(HaCClientInfo*, const HaCPbufView&)> fn);
         void onSent(std::function<void(uint16_t, HaCClientInfo*)> fn);
         void onError(std::function<void(uint16_t, HaCClientInfo*)> fn);
         void onPoll(std::function<void(HaCClientInfo*)> fn);
+        void onBufferReleased(std::function<void(HaCClientInfo*, const void*)> fn);
+        void onWritable(std::function<void(HaCClientInfo*)> fn);
+        void onMessageSent(std::function<void(HaCClientInfo*, HaCMessageToken, uint32_t)> fn);
+        #ifndef HAC_ENABLE_STATIC_MEMORY
+        //Build a vector of the connected clients on every event, see onClientJoined and onClientLeft
         void onClosed(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn); 
         void onNewConnection(std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> fn);       
+        #endif
+        void onClientJoined(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn);
+        void onClientLeft(std::function<void(HaCClientInfo*, const HaCClientRoster&)> fn);
         /* #endregion */
         
     private:
-        bool _enablePingWatchdog = true;
+        HaCWatchdogMode _watchdogMode = HAC_WATCHDOG_PING;
+        uint32_t _keepAliveIdle = HAC_KEEPALIVE_DEF_IDLE;
+        uint32_t _keepAliveInterval = HAC_KEEPALIVE_DEF_INTERVAL;
+        uint8_t _keepAliveCount = HAC_KEEPALIVE_DEF_COUNT;
+        uint32_t _idleTimeoutMs = 0;
+        bool _manualReceiveWindow = false;
+        uint32_t _txHighWatermark = HAC_SOCCLIENT_TX_HIGH_WATERMARK;
+        uint32_t _txLowWatermark = 0;
+        HaCSlowConsumerPolicy _slowConsumerPolicy = HAC_SLOW_CONSUMER_DROP_NEWEST;
+        bool _noDelay = false;
+        uint8_t _maxClients = HAC_SERVER_MAX_SOCKET_CLIENTS;
+        uint8_t _backlog = HAC_SERVER_MAX_SOCKET_CLIENTS;
+        HaCAdmissionPolicy _admissionPolicy = HAC_ADMISSION_REFUSE;
+        uint32_t _retryAfterMs = HAC_SERVER_DEF_RETRY_AFTER_MS;
+        HaCReceiveMode _receiveMode = HAC_RX_MODE_TEXT;
+        char _frameDelimiter[HAC_FRAMER_MAX_DELIMITER_LEN + 1] = HAC_FRAMER_DEF_DELIMITER;
+        uint16_t _maxFrameLength = HAC_FRAMER_DEF_MAX_LENGTH;
+        HaCLengthPrefix _lengthPrefix = HAC_LEN_PREFIX_U16;
         uint16_t _port = HAC_SERVER_DEF_PORT;
         tcp_pcb *_listenerSoc = nullptr;
         //IPAddress _ipAddr;
         ip_addr_t *_ipAddr = nullptr;
-        std::vector<HaCClientInfo*> _clientInfos = std::vector<HaCClientInfo*>();
-        HaCClientInfo *_clientInfo = nullptr;
+        HaCClientPool *_pool = &HaCClientPool::shared();
 
-        std::function<void(HaCClientInfo*, const char*, uint16_t, uint32_t)> _onReceiveFn;
-        std::function<void(uint16_t, HaCClientInfo*)> _onSentFn;
-        std::function<void(uint16_t, HaCClientInfo*)> _onErrorFn;
-        std::function<void(HaCClientInfo*)> _onPollFn;
+        HaCClientCallbacks _clientCallbacks; //Shared by every connection
+        #ifndef HAC_ENABLE_STATIC_MEMORY
         std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> _onClosedFn;
         std::function<void(HaCClientInfo*, std::vector<HaCClientInfo*>)> _onNewConnectionFn;
+        #endif
+        std::function<void(HaCClientInfo*, const HaCClientRoster&)> _onClientJoinedFn;
+        std::function<void(HaCClientInfo*, const HaCClientRoster&)> _onClientLeftFn;
 
         /* #region Private Lambda functions(ClientInfo Events) */
         void _clientInfo_onClosed(HaCClientInfo * clientInfo);
         void _clientInfo_onAccepted(HaCClientInfo * clientInfo);
         /* #endregion */
 
+        #ifndef HAC_ENABLE_STATIC_MEMORY
+        std::vector<HaCClientInfo*> _connectedClients();
+        #endif
+        bool _refuse(tcp_pcb *soc);
+
         err_t _accept(tcp_pcb* newpcb, err_t err);
         static err_t _accept(void *arg, tcp_pcb* newpcb, err_t err);
 };
@@ -0,0 +1,96 @@
+/**
+ *
+ * @file HaCSharedBuffer.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef __HAC_SHAREDBUFFER_H_
+#define __HAC_SHAREDBUFFER_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+#include <new>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifdef HAC_ENABLE_STATIC_MEMORY
+#ifndef HAC_SHARED_BUFFER_POOL_SIZE
+#define HAC_SHARED_BUFFER_POOL_SIZE     2
+#endif
+
+#ifndef HAC_SHARED_BUFFER_BLOCK_SIZE
+#define HAC_SHARED_BUFFER_BLOCK_SIZE    256
+#endif
+#endif
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Reference counted payload shared by several send queues.
+     * The header and the payload live on a single allocation which is freed
+     * when the last reference is released. With HAC_ENABLE_STATIC_MEMORY the blocks 
+     * come from a fixed pool of HAC_SHARED_BUFFER_POOL_SIZE blocks instead.
+     */
+class HaCSharedBuffer
+{
+    public:
+        static HaCSharedBuffer* create(const void *data, uint16_t len);
+
+        void retain();
+        void release();
+
+        const uint8_t* data() const;
+        uint16_t length() const;
+        uint16_t references() const;
+
+    private:
+        uint16_t _len = 0;
+        uint16_t _references = 1;
+        #ifdef HAC_ENABLE_STATIC_MEMORY
+        uint8_t _block = 0;
+
+        static uint8_t* _blockAt(uint8_t index);
+        static bool* _blockUsed();
+        #endif
+
+        HaCSharedBuffer(uint16_t len);
+        ~HaCSharedBuffer();
+        HaCSharedBuffer(const HaCSharedBuffer&) = delete;
+        HaCSharedBuffer& operator=(const HaCSharedBuffer&) = delete;
+};
+/* #endregion */
+
+#include "HaCSharedBuffer-impl.h"
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ *
+ * @file HaCTimerWheel.h
+ * @date 17.10.2026
+ * @author Harvy Aronales Costiniano
+ * 
+ * Copyright (c) 2023 Harvy Aronales Costiniano. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#ifndef __HAC_TIMERWHEEL_H_
+#define __HAC_TIMERWHEEL_H_
+
+
+/* #region CONSTANT_DEFINITION */
+
+/* #region Debug */
+/* #endregion */
+
+/* #endregion */
+
+/* #region INTERNAL_DEPENDENCY */
+#include "HaCEspSockets.h"
+/* #endregion */
+
+/* #region EXTERNAL_DEPENDENCY */
+#include <Arduino.h>
+#include <lwip/timeouts.h>
+/* #endregion */
+
+/* #region GLOBAL_DECLARATION */
+#ifndef HAC_TIMER_TICK_MS
+#define HAC_TIMER_TICK_MS       100
+#endif
+
+#define HAC_TIMER_WHEEL_BITS    6
+#define HAC_TIMER_WHEEL_SLOTS   (1 << HAC_TIMER_WHEEL_BITS)
+#define HAC_TIMER_WHEEL_MASK    (HAC_TIMER_WHEEL_SLOTS - 1)
+
+typedef void (*HaCTimerFn)(void *ctx);
+
+/**
+     * One timer, owned by its user and linked into the wheel while it is running
+     */
+struct HaCTimer
+{
+    HaCTimer *next = nullptr;
+    HaCTimer **pprev = nullptr;//Link pointing at this timer, nullptr if not running
+    uint32_t expires = 0;//Wheel tick
+    HaCTimerFn fn = nullptr;
+    void *ctx = nullptr;
+};
+/* #endregion */
+
+/* #region CLASS_DECLARATION */
+
+/**
+     * Library wide two level timer wheel driven by a single lwIP timeout.
+     * Starting and stopping a timer is O(1), a tick only touches the timers that expire
+     * (and once every HAC_TIMER_WHEEL_SLOTS ticks the next far slot), no matter how many 
+     * timers are running. The lwIP timeout is only armed while a timer is running.
+     */
+class HaCTimerWheel
+{
+    public:
+        static HaCTimerWheel& instance();
+
+        HaCTimerWheel(const HaCTimerWheel&) = delete;
+        HaCTimerWheel& operator=(const HaCTimerWheel&) = delete;
+
+        void start(HaCTimer *timer, uint32_t delayMs, HaCTimerFn fn, void *ctx);
+        void stop(HaCTimer *timer);
+        bool isActive(const HaCTimer *timer) const;
+        uint16_t count() const;
+        void advance();
+        void check();
+
+    private:
+        HaCTimer *_near[HAC_TIMER_WHEEL_SLOTS];//One slot per tick
+        HaCTimer *_far[HAC_TIMER_WHEEL_SLOTS];//One slot per HAC_TIMER_WHEEL_SLOTS ticks
+        uint32_t _tick = 0;
+        uint32_t _tickMs = 0;
+        uint16_t _count = 0;
+        bool _armed = false;
+        uint32_t _armedMs = 0;
+
+        HaCTimerWheel();
+
+        void _link(HaCTimer *timer);
+        void _unlink(HaCTimer *timer);
+        void _cascade();
+        void _expire();
+        void _arm();
+        static void _onTick(void *arg);
+};
+/* #endregion */
+
+#include "HaCTimerWheel-impl.h"
+
+#endif